@@ -3,6 +3,10 @@ import class Foundation.ProcessInfo
 // swift-tools-version: 6.1
 import PackageDescription
 
+/// `AIDLAB_TRACING=1 swift build` compiles the `Device.tracer` trace points in.
+let tracingSettings: [SwiftSetting] =
+    ProcessInfo.processInfo.environment["AIDLAB_TRACING"] == "1" ? [.define("AIDLAB_TRACING")] : []
+
 let package = Package(
     name: "Aidlab",
     platforms: [
@@ -25,10 +29,23 @@ let package = Package(
         .target(
             name: "Aidlab",
             dependencies: ["AidlabSDK"],
+            swiftSettings: tracingSettings,
             linkerSettings: [
                 .linkedLibrary("c++"),
                 .linkedLibrary("z")
             ]
+        ),
+        .executableTarget(
+            name: "AidlabBenchmark",
+            dependencies: ["Aidlab", "AidlabSDK"],
+            linkerSettings: [
+                .linkedLibrary("c++"),
+                .linkedLibrary("z")
+            ]
+        ),
+        .testTarget(
+            name: "AidlabTests",
+            dependencies: ["Aidlab"]
         )
     ]
 )
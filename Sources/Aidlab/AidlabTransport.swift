@@ -17,12 +17,21 @@ public protocol AidlabTransport: AnyObject {
     func disconnect()
 
     func readCharacteristic(_ uuid: CBUUID, completion: @escaping (Result<Data, Error>) -> Void)
+    /// - Note: `data` may be a slice of a larger frame buffer; do not assume its `startIndex` is 0.
     func writeCharacteristic(_ uuid: CBUUID, data: Data, withResponse: Bool, completion: @escaping (Result<Void, Error>) -> Void)
 
+    /// Writes without response `Device` may have submitted but not yet completed; the transport queues them and
+    /// sends as many per pass as the link accepts. Writes with response are always issued one at a time.
+    var writeWithoutResponseCredits: Int { get }
+
     func startNotifications(_ uuid: CBUUID, onData: @escaping (Data) -> Void, onError: @escaping (Error) -> Void)
     func stopNotifications(_ uuid: CBUUID)
 }
 
+public extension AidlabTransport {
+    var writeWithoutResponseCredits: Int { 1 }
+}
+
 protocol CoreBluetoothLifecycleForwarding: AnyObject {
     func notifyDidConnect()
     func notifyDidFailToConnect(error: Error?)
@@ -0,0 +1,73 @@
+import Foundation
+
+/// FIFO of ATT-sized writes waiting for the command characteristic.
+///
+/// Chunks are slices of the frame they were cut from, so a frame costs a single buffer however many writes
+/// it spans, and the descriptors live in a ring that is reused across frames instead of an array that is
+/// shifted on every pop.
+struct BLEChunkQueue {
+    struct Chunk {
+        let data: Data
+        let completesFrame: Bool
+    }
+
+    private var ring: [Chunk?]
+    private var head = 0
+    private(set) var count = 0
+
+    init(capacity: Int = 64) {
+        ring = Array(repeating: nil, count: max(1, capacity))
+    }
+
+    var isEmpty: Bool { count == 0 }
+
+    /// Splits `frame` into writes of at most `chunkSize` bytes. Only the last one can complete the frame.
+    mutating func enqueueFrame(_ frame: Data, chunkSize: Int, completesFrame: Bool) {
+        var offset = frame.startIndex
+        while offset < frame.endIndex {
+            let endIndex = min(offset + chunkSize, frame.endIndex)
+            append(
+                Chunk(
+                    data: frame[offset ..< endIndex],
+                    completesFrame: completesFrame && endIndex == frame.endIndex
+                )
+            )
+            offset = endIndex
+        }
+    }
+
+    mutating func popFirst() -> Chunk? {
+        guard count > 0 else { return nil }
+        let chunk = ring[head]
+        ring[head] = nil
+        head = (head + 1) % ring.count
+        count -= 1
+        return chunk
+    }
+
+    /// Drops queued chunks but keeps the ring storage for the next frame.
+    mutating func removeAll() {
+        for index in 0 ..< count {
+            ring[(head + index) % ring.count] = nil
+        }
+        head = 0
+        count = 0
+    }
+
+    private mutating func append(_ chunk: Chunk) {
+        if count == ring.count {
+            grow()
+        }
+        ring[(head + count) % ring.count] = chunk
+        count += 1
+    }
+
+    private mutating func grow() {
+        var newRing = [Chunk?](repeating: nil, count: ring.count * 2)
+        for index in 0 ..< count {
+            newRing[index] = ring[(head + index) % ring.count]
+        }
+        ring = newRing
+        head = 0
+    }
+}
@@ -0,0 +1,205 @@
+@preconcurrency import CoreBluetooth
+import Foundation
+
+/// Append-only log of the raw BLE traffic of a device, for reproducing decode and performance issues offline.
+///
+/// Attach it with `Device.capture`. Every notification handed to the SDK and every frame the SDK emits is
+/// appended with its host receive time. Storage is reserved up front so that recording stays cheap on the
+/// receive path.
+///
+/// Serialized layout (little-endian):
+///
+///     "ALCP" | version: u8 | revisionLength: u8 | firmware revision (UTF-8)
+///     repeated: kind: u8 | hostTimeNanoseconds: u64 | length: u32 | bytes
+public final class ChunkCapture: @unchecked Sendable {
+    public enum Kind: UInt8, Sendable {
+        case commandChunk = 0
+        case outboundFrame = 1
+        case legacyECG = 2
+        case legacyTemperature = 3
+        case legacyRespiration = 4
+        case legacyMotion = 5
+        case legacySoundVolume = 6
+        case legacySteps = 7
+        case legacyActivity = 8
+        case legacyOrientation = 9
+        case legacyHeartRate = 10
+        case battery = 11
+    }
+
+    public struct Record: Sendable {
+        public let kind: Kind
+        /// Monotonic host time; only meaningful relative to other records of the same capture.
+        public let hostTimeNanoseconds: UInt64
+        public let bytes: Data
+    }
+
+    private static let magic: [UInt8] = Array("ALCP".utf8)
+    private static let version: UInt8 = 1
+    private static let recordHeaderLength = 13
+
+    private let lock = NSLock()
+    private var revision: String
+    private var storage: [UInt8] = []
+
+    /// - Parameter reservedCapacity: Bytes reserved for records so appends do not reallocate.
+    public init(firmwareRevision: String = "", reservedCapacity: Int = 4 << 20) {
+        revision = firmwareRevision
+        storage.reserveCapacity(reservedCapacity)
+    }
+
+    /// Loads a capture previously produced by `data` or `write(to:)`.
+    public init(data: Data) throws {
+        let bytes = [UInt8](data)
+        guard bytes.count >= 6, Array(bytes[0 ..< 4]) == ChunkCapture.magic else {
+            throw AidlabError(message: "Not a chunk capture")
+        }
+        guard bytes[4] == ChunkCapture.version else {
+            throw AidlabError(message: "Unsupported chunk capture version \(bytes[4])")
+        }
+        let revisionEnd = 6 + Int(bytes[5])
+        guard revisionEnd <= bytes.count else {
+            throw AidlabError(message: "Truncated chunk capture header")
+        }
+        revision = String(decoding: bytes[6 ..< revisionEnd], as: UTF8.self)
+        storage = Array(bytes[revisionEnd...])
+        _ = try parseRecords()
+    }
+
+    public convenience init(contentsOf url: URL) throws {
+        try self.init(data: Data(contentsOf: url, options: .alwaysMapped))
+    }
+
+    /// Firmware revision of the captured device; filled in by `Device` when its SDK instance is created.
+    public var firmwareRevision: String {
+        get {
+            lock.lock()
+            defer { lock.unlock() }
+            return revision
+        }
+        set {
+            lock.lock()
+            revision = newValue
+            lock.unlock()
+        }
+    }
+
+    public var records: [Record] {
+        (try? parseRecords()) ?? []
+    }
+
+    public var data: Data {
+        lock.lock()
+        let revisionBytes = Array(revision.utf8.prefix(Int(UInt8.max)))
+        var data = Data(capacity: 6 + revisionBytes.count + storage.count)
+        data.append(contentsOf: ChunkCapture.magic)
+        data.append(ChunkCapture.version)
+        data.append(UInt8(revisionBytes.count))
+        data.append(contentsOf: revisionBytes)
+        data.append(contentsOf: storage)
+        lock.unlock()
+        return data
+    }
+
+    public func write(to url: URL) throws {
+        try data.write(to: url, options: .atomic)
+    }
+
+    /// Drops recorded traffic but keeps the reserved storage.
+    public func removeAll() {
+        lock.lock()
+        storage.removeAll(keepingCapacity: true)
+        lock.unlock()
+    }
+
+    func append(_ kind: Kind, _ bytes: UnsafeRawBufferPointer) {
+        let hostTime = DispatchTime.now().uptimeNanoseconds
+        lock.lock()
+        storage.append(kind.rawValue)
+        withUnsafeBytes(of: hostTime.littleEndian) { storage.append(contentsOf: $0) }
+        withUnsafeBytes(of: UInt32(bytes.count).littleEndian) { storage.append(contentsOf: $0) }
+        storage.append(contentsOf: bytes)
+        lock.unlock()
+    }
+
+    func append(_ kind: Kind, _ data: Data) {
+        data.withUnsafeBytes { append(kind, $0) }
+    }
+
+    private func parseRecords() throws -> [Record] {
+        lock.lock()
+        defer { lock.unlock() }
+
+        var records: [Record] = []
+        var offset = 0
+        while offset < storage.count {
+            guard storage.count - offset >= ChunkCapture.recordHeaderLength else {
+                throw AidlabError(message: "Truncated chunk capture record at byte \(offset)")
+            }
+            let rawKind = storage[offset]
+            let hostTime = storage[offset + 1 ..< offset + 9].reversed().reduce(UInt64(0)) { $0 << 8 | UInt64($1) }
+            let length = Int(storage[offset + 9 ..< offset + 13].reversed().reduce(UInt32(0)) { $0 << 8 | UInt32($1) })
+            let start = offset + ChunkCapture.recordHeaderLength
+            guard length <= storage.count - start else {
+                throw AidlabError(message: "Truncated chunk capture record at byte \(offset)")
+            }
+            if let kind = Kind(rawValue: rawKind) {
+                records.append(Record(kind: kind, hostTimeNanoseconds: hostTime, bytes: Data(storage[start ..< start + length])))
+            }
+            offset = start + length
+        }
+        return records
+    }
+}
+
+public extension ChunkCapture {
+    /// Feeds the captured notifications through a fresh SDK instance as fast as possible and delivers the decoded
+    /// data to `delegate` exactly as a live `Device` would. Captured outbound frames are not re-sent.
+    ///
+    /// - Parameter configure: Applied to the replay device before the first record, e.g. to enable `measuresLatency`.
+    /// - Returns: The replay device, for reading `statistics` or `latency` afterwards. Its SDK instance is gone.
+    @discardableResult
+    func replay(delegate: DeviceDelegate, configure: (Device) -> Void = { _ in }) throws -> Device {
+        let device = Device(transport: ReplayTransport())
+        device.firmwareRevision = firmwareRevision
+        device.deviceDelegate = delegate
+        configure(device)
+        device.createAidlabSDK()
+        guard device.session != nil else {
+            throw AidlabError(message: "SDK rejected firmware revision \(firmwareRevision)")
+        }
+        defer { device.destroyAidlabSDK() }
+
+        for record in try parseRecords() where record.kind != .outboundFrame {
+            device.ingest(record)
+        }
+        return device
+    }
+}
+
+/// Transport behind a replayed device: accepts every write and never delivers notifications on its own.
+private final class ReplayTransport: AidlabTransport {
+    let address = UUID()
+    let name: String? = "Replay"
+    var rssi: NSNumber = 0
+    let mtuSize = 244
+    var onDisconnect: ((DisconnectReason, Error?) -> Void)?
+
+    func connect(completion: @escaping (Result<Void, Error>) -> Void) {
+        completion(.success(()))
+    }
+
+    func disconnect() {}
+
+    func readCharacteristic(_ uuid: CBUUID, completion: @escaping (Result<Data, Error>) -> Void) {
+        completion(.failure(AidlabError(message: "Characteristic \(uuid.uuidString) unavailable")))
+    }
+
+    func writeCharacteristic(_: CBUUID, data _: Data, withResponse _: Bool, completion: @escaping (Result<Void, Error>) -> Void) {
+        completion(.success(()))
+    }
+
+    func startNotifications(_: CBUUID, onData _: @escaping (Data) -> Void, onError _: @escaping (Error) -> Void) {}
+
+    func stopNotifications(_: CBUUID) {}
+}
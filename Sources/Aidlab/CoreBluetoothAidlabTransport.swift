@@ -8,6 +8,8 @@ final class CoreBluetoothAidlabTransport: NSObject, AidlabTransport, CoreBluetoo
     var address: UUID { peripheral.identifier }
     var name: String? { peripheral.name }
     var mtuSize: Int { peripheral.maximumWriteValueLength(for: .withoutResponse) }
+    /// Enough queued chunks to refill the link's buffer in one `peripheralIsReady` pass.
+    var writeWithoutResponseCredits: Int { 8 }
 
     var onRSSIRead: (@Sendable (NSNumber) -> Void)?
 
@@ -228,17 +230,20 @@ final class CoreBluetoothAidlabTransport: NSObject, AidlabTransport, CoreBluetoo
     }
 
     private func drainWithoutResponseWrites() {
-        guard peripheral.canSendWriteWithoutResponse, !pendingWithoutResponseWrites.isEmpty else {
-            return
+        var sent: [(Result<Void, Error>) -> Void] = []
+        while peripheral.canSendWriteWithoutResponse, !pendingWithoutResponseWrites.isEmpty {
+            let pendingWrite = pendingWithoutResponseWrites.removeFirst()
+            peripheral.writeValue(
+                pendingWrite.data,
+                for: pendingWrite.characteristic,
+                type: .withoutResponse
+            )
+            sent.append(pendingWrite.completion)
+        }
+        // Completions run after the pass: they may submit further writes, which re-enter this drain.
+        for completion in sent {
+            completion(.success(()))
         }
-
-        let pendingWrite = pendingWithoutResponseWrites.removeFirst()
-        peripheral.writeValue(
-            pendingWrite.data,
-            for: pendingWrite.characteristic,
-            type: .withoutResponse
-        )
-        pendingWrite.completion(.success(()))
     }
 
     private func mapDisconnectReason(error: Error?) -> DisconnectReason {
@@ -23,3 +23,38 @@ public enum DataType: Int, Sendable {
     case eda = 16
     case gps = 17
 }
+
+/// Set of `DataType`s with bit `n` standing for the data type of raw value `n`, the layout of `collect flags`.
+public struct DataTypeMask: OptionSet, Sendable {
+    public let rawValue: UInt32
+
+    public init(rawValue: UInt32) {
+        self.rawValue = rawValue
+    }
+
+    public init(_ dataType: DataType) {
+        rawValue = 1 << dataType.rawValue
+    }
+
+    public init(_ dataTypes: some Sequence<DataType>) {
+        rawValue = dataTypes.reduce(0) { $0 | 1 << $1.rawValue }
+    }
+
+    public static let all = DataTypeMask(rawValue: .max)
+
+    public static let ecg = DataTypeMask(.ecg)
+    public static let respiration = DataTypeMask(.respiration)
+    public static let skinTemperature = DataTypeMask(.skinTemperature)
+    public static let motion = DataTypeMask(.motion)
+    public static let activity = DataTypeMask(.activity)
+    public static let orientation = DataTypeMask(.orientation)
+    public static let steps = DataTypeMask(.steps)
+    public static let heartRate = DataTypeMask(.heartRate)
+    public static let soundVolume = DataTypeMask(.soundVolume)
+    public static let rr = DataTypeMask(.rr)
+    public static let pressure = DataTypeMask(.pressure)
+    public static let respirationRate = DataTypeMask(.respirationRate)
+    public static let bodyPosition = DataTypeMask(.bodyPosition)
+    public static let eda = DataTypeMask(.eda)
+    public static let gps = DataTypeMask(.gps)
+}
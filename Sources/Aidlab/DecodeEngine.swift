@@ -0,0 +1,45 @@
+import Foundation
+
+/// Fixed pool of decode workers shared by many devices.
+///
+/// Assign the same engine to every `Device` on a hub before calling `connect`. Each connection is pinned to
+/// one worker, so a device's chunks are decoded in order while different devices decode in parallel. All
+/// calls into that device's SDK instance run on its worker, and outgoing BLE writes are handed back to
+/// `transportQueue`, the queue the transport delivers its callbacks on.
+///
+/// With an engine, `DeviceDelegate` data callbacks arrive on the worker threads.
+public final class DecodeEngine: @unchecked Sendable {
+    struct Worker {
+        let queue: DispatchQueue
+        let transportQueue: DispatchQueue
+    }
+
+    public let workerCount: Int
+    public let transportQueue: DispatchQueue
+
+    private let workers: [Worker]
+    private let lock = NSLock()
+    private var nextWorker = 0
+
+    public init(
+        workerCount: Int = ProcessInfo.processInfo.activeProcessorCount,
+        transportQueue: DispatchQueue = .main,
+        qos: DispatchQoS = .userInitiated
+    ) {
+        let workerCount = max(1, workerCount)
+        self.workerCount = workerCount
+        self.transportQueue = transportQueue
+        workers = (0 ..< workerCount).map { index in
+            Worker(queue: DispatchQueue(label: "com.aidlab.decode.\(index)", qos: qos), transportQueue: transportQueue)
+        }
+    }
+
+    /// Round-robin so that devices connecting together land on different workers.
+    func assignWorker() -> Worker {
+        lock.lock()
+        defer { lock.unlock() }
+        let worker = workers[nextWorker]
+        nextWorker = (nextWorker + 1) % workers.count
+        return worker
+    }
+}
@@ -0,0 +1,109 @@
+import Foundation
+
+/// One connection's SDK instance, together with the delegate and decode settings it was started with.
+///
+/// Everything that runs inside the SDK reads the session instead of the `Device` properties the application may
+/// change on its own thread. Settings changed while connected reach the session through `update`, in order with
+/// the chunks decoded around them.
+///
+/// With a `DecodeEngine` the session runs on a serial queue of its own that targets the assigned worker. That queue
+/// starts only once the previous session of the same device has been torn down, so two sessions of one device never
+/// decode at the same time, and neither the caller nor the worker waits for it.
+final class DecodeSession: @unchecked Sendable {
+    struct Settings {
+        var enabledDataTypes: DataTypeMask
+        var synchronizationPageSize: Int?
+        var capture: ChunkCapture?
+        var recorder: SignalRecorder?
+        var sampleRings: SampleRings?
+        var reportsStreamDescriptors: Bool
+        var measuresLatency: Bool
+        var tracer: AidlabTracer?
+    }
+
+    let delegate: DeviceDelegate?
+    /// Only read and written where the session runs; see `enqueue`.
+    var settings: Settings
+    /// Where the session hands outgoing writes and their failures back to the transport: the engine's
+    /// `transportQueue` (main for a session queued without an engine), or `nil` when the session runs inline on
+    /// the transport's own thread.
+    let transportQueue: DispatchQueue?
+    /// Left once the session's instance is destroyed.
+    let ended = DispatchGroup()
+
+    private let aidlabSDK: UnsafeMutableRawPointer
+    private let queue: DispatchQueue?
+    private let queueKey = DispatchSpecificKey<Void>()
+    private var isEnded = false
+
+    /// - Parameter previous: The session this device ran before. If its teardown is still queued somewhere, this
+    ///   session gets a queue even without a worker and starts it once that teardown is done.
+    init(
+        aidlabSDK: UnsafeMutableRawPointer,
+        delegate: DeviceDelegate?,
+        settings: Settings,
+        worker: DecodeEngine.Worker?,
+        after previous: DecodeSession?
+    ) {
+        self.aidlabSDK = aidlabSDK
+        self.delegate = delegate
+        self.settings = settings
+        let previousEnded = previous?.ended
+        let waitsForPrevious = previousEnded?.wait(timeout: .now()) == .timedOut
+        if worker != nil || waitsForPrevious {
+            queue = DispatchQueue(label: "com.aidlab.session", attributes: .initiallyInactive, target: worker?.queue)
+            transportQueue = worker?.transportQueue ?? .main
+        } else {
+            queue = nil
+            transportQueue = nil
+        }
+
+        ended.enter()
+        guard let queue else { return }
+        queue.setSpecific(key: queueKey, value: ())
+        if let previousEnded, waitsForPrevious {
+            previousEnded.notify(queue: .global()) { queue.activate() }
+        } else {
+            queue.activate()
+        }
+    }
+
+    /// Runs `body` after everything sent to the session before it: inline when the session has no queue or the
+    /// caller is already on it, otherwise asynchronously on the queue.
+    func enqueue(_ body: @escaping @Sendable () -> Void) {
+        guard let queue, DispatchQueue.getSpecific(key: queueKey) == nil else {
+            body()
+            return
+        }
+        queue.async(execute: body)
+    }
+
+    /// Like `enqueue`, passing the instance; `nil` once the session has ended.
+    func useInstance(_ body: @escaping @Sendable (UnsafeMutableRawPointer?) -> Void) {
+        enqueue { [self] in
+            body(isEnded ? nil : aidlabSDK)
+        }
+    }
+
+    func update(_ body: @escaping @Sendable (inout Settings) -> Void) {
+        enqueue { [self] in
+            body(&settings)
+        }
+    }
+
+    /// Runs `teardown` with the instance after everything already sent to the session and leaves `ended`. Always
+    /// queued when the session has a queue, so a callback that ends the connection never frees the instance while
+    /// the SDK is still running it.
+    func end(_ teardown: @escaping @Sendable (UnsafeMutableRawPointer) -> Void) {
+        let body: @Sendable () -> Void = { [self] in
+            teardown(aidlabSDK)
+            isEnded = true
+            ended.leave()
+        }
+        if let queue {
+            queue.async(execute: body)
+        } else {
+            body()
+        }
+    }
+}
@@ -0,0 +1,487 @@
+import AidlabSDK
+import Foundation
+
+extension Device {
+    func registerCallbacks(on aidlabSDK: UnsafeMutableRawPointer) {
+        let context = Unmanaged.passUnretained(self).toOpaque()
+        AidlabSDK_set_context(context, aidlabSDK)
+        AidlabSDK_set_error_callback(Device.didReceiveError, context, aidlabSDK)
+
+        AidlabSDK_set_ble_send_callback(Device.bleSendCallback, aidlabSDK)
+        AidlabSDK_set_ble_ready_callback(Device.bleReadyCallback, aidlabSDK)
+
+        AidlabSDK_init_callbacks(Device.didReceiveECG,
+                                 Device.didReceiveRespiration,
+                                 Device.didReceiveSkinTemperature,
+                                 Device.didReceiveAccelerometer,
+                                 Device.didReceiveGyroscope,
+                                 Device.didReceiveMagnetometer,
+                                 Device.didReceiveBatteryLevel,
+                                 Device.didDetectActivity,
+                                 Device.didReceiveSteps,
+                                 Device.didReceiveOrientation,
+                                 Device.didReceiveQuaternion,
+                                 Device.didReceiveRespirationRate,
+                                 Device.wearStateDidChange,
+                                 Device.didReceiveHeartRate,
+                                 Device.didReceiveRr,
+                                 Device.didReceiveSoundVolume,
+                                 Device.didDetect,
+                                 Device.didDetectUserEvent,
+                                 Device.didReceivePressure,
+                                 Device.pressureWearStateDidChange,
+                                 Device.didReceiveBodyPosition,
+                                 Device.didReceiveSignalQuality,
+                                 aidlabSDK)
+
+        AidlabSDK_set_eda_callback(Device.didReceiveEDA, aidlabSDK)
+        AidlabSDK_set_gps_callback(Device.didReceiveGPS, aidlabSDK)
+
+        AidlabSDK_set_payload_callback(Device.didReceivePayload, aidlabSDK)
+        AidlabSDK_set_process_error_callback(Device.didReceiveProcessError, aidlabSDK)
+
+        AidlabSDK_init_synchronization_callbacks(Device.syncStateDidChange, Device.didReceiveUnsynchronizedSize, Device.didReceivePastECG, Device.didReceivePastRespiration, Device.didReceivePastSkinTemperature, Device.didReceivePastHeartRate, Device.didReceivePastRr, Device.didReceivePastActivity, Device.didReceivePastRespirationRate, Device.didReceivePastSteps, Device.didDetectPastUserEvent, Device.didReceivePastSoundVolume, Device.didReceivePastPressure, Device.didReceivePastAccelerometer, Device.didReceivePastGyroscope, Device.didReceivePastQuaternion, Device.didReceivePastOrientation, Device.didReceivePastMagnetometer, Device.didReceivePastBodyPosition, Device.didReceivePastSignalQuality, aidlabSDK)
+        AidlabSDK_set_past_eda_callback(Device.didReceivePastEDA, aidlabSDK)
+        AidlabSDK_set_past_gps_callback(Device.didReceivePastGPS, aidlabSDK)
+    }
+
+    // BLE Communication callbacks
+    private static let bleSendCallback: callbackBLESend = { context, data, size in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+
+        let completesFrame = self_.consumeTrackedFrameCallback()
+        guard let data, size > 0 else { return }
+        self_.traced(.frameSend) {
+            let session = self_.decodingSession
+            session?.settings.capture?.append(.outboundFrame, UnsafeRawBufferPointer(start: data, count: Int(size)))
+            self_.statisticsCollector.recordFrameSent(byteCount: Int(size))
+            let frame = Data(bytes: data, count: Int(size))
+            // Frames emitted on a session queue are written from the transport's own queue.
+            if let transportQueue = session?.transportQueue {
+                transportQueue.async {
+                    self_.sendRawBleData(frame, completesFrame: completesFrame)
+                }
+            } else {
+                self_.sendRawBleData(frame, completesFrame: completesFrame)
+            }
+        }
+    }
+
+    private static let bleReadyCallback: callbackBLEReady = { context in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.completeFrameConfirmation()
+    }
+
+    private static let didReceiveECG: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.ecg) else { return }
+        self_.account(.ecg)
+        self_.bufferSample(self_.ecgSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceiveRespiration: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.respiration) else { return }
+        self_.account(.respiration)
+        self_.bufferSample(self_.respirationSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceiveSkinTemperature: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.skinTemperature) else { return }
+        self_.account(.skinTemperature)
+        self_.bufferSample(self_.skinTemperatureSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceiveAccelerometer: callbackAccelerometer = { context, timestamp, ax, ay, az in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.accelerometerSamples, timestamp: timestamp, x: ax, y: ay, z: az)
+    }
+
+    private static let didReceiveGyroscope: callbackGyroscope = { context, timestamp, gx, gy, gz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.gyroscopeSamples, timestamp: timestamp, x: gx, y: gy, z: gz)
+    }
+
+    private static let didReceiveMagnetometer: callbackMagnetometer = { context, timestamp, mx, my, mz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.magnetometerSamples, timestamp: timestamp, x: mx, y: my, z: mz)
+    }
+
+    private static let didReceiveQuaternion: callbackQuaternion = { context, timestamp, qw, qx, qy, qz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.quaternionSamples, timestamp: timestamp, w: qw, x: qx, y: qy, z: qz)
+    }
+
+    private static let didReceiveOrientation: callbackOrientation = { context, timestamp, roll, pitch, yaw in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.orientation) else { return }
+        self_.account(.orientation)
+        self_.decodingSession?.delegate?.didReceiveOrientation(self_, timestamp: timestamp, roll: roll, pitch: pitch, yaw: yaw)
+    }
+
+    private static let didReceiveEDA: callbackEda = { context, timestamp, conductance in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.eda) else { return }
+        self_.account(.eda)
+        self_.decodingSession?.delegate?.didReceiveEDA(self_, timestamp: timestamp, conductance: conductance)
+    }
+
+    private static let didReceiveGPS: callbackGps = { context, timestamp, latitude, longitude, altitude, speed, heading, hdop in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.gps) else { return }
+        self_.account(.gps)
+        self_.decodingSession?.delegate?.didReceiveGPS(self_,
+                                            timestamp: timestamp,
+                                            latitude: Double(latitude),
+                                            longitude: Double(longitude),
+                                            altitude: Double(altitude),
+                                            speed: speed,
+                                            heading: heading,
+                                            hdop: hdop)
+    }
+
+    private static let didReceiveBodyPosition: callbackBodyPosition = { context, timestamp, bodyPosition in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.bodyPosition) else { return }
+        self_.account(.bodyPosition)
+        self_.decodingSession?.delegate?.didReceiveBodyPosition(self_, timestamp: timestamp, bodyPosition: BodyPosition(bodyPosition: bodyPosition))
+    }
+
+    private static let didReceiveHeartRate: callbackHeartRate = { context, timestamp, heartRate in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.heartRate) else { return }
+        self_.account(.heartRate)
+        self_.decodingSession?.delegate?.didReceiveHeartRate(self_, timestamp: timestamp, heartRate: heartRate)
+    }
+
+    private static let didReceiveRr: callbackRr = { context, timestamp, rr in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.rr) else { return }
+        self_.account(.rr)
+        self_.decodingSession?.delegate?.didReceiveRr(self_, timestamp: timestamp, rr: rr)
+    }
+
+    private static let didReceiveRespirationRate: callbackRespirationRate = { context, timestamp, respirationRate in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.respirationRate) else { return }
+        self_.account(.respirationRate)
+        self_.decodingSession?.delegate?.didReceiveRespirationRate(self_, timestamp: timestamp, value: respirationRate)
+    }
+
+    private static let wearStateDidChange: callbackWearState = { context, state in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.wearStateDidChange(self_, wearState: WearState(wearState: state))
+    }
+
+    private static let didReceiveSoundVolume: callbackSoundVolume = { context, timestamp, soundVolume in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.soundVolume) else { return }
+        self_.account(.soundVolume)
+        self_.decodingSession?.delegate?.didReceiveSoundVolume(self_, timestamp: timestamp, soundVolume: soundVolume)
+    }
+
+    private static let didReceivePressure: callbackPressure = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.pressure) else { return }
+        self_.account(.pressure)
+        self_.decodingSession?.delegate?.didReceivePressure(self_, timestamp: timestamp, value: value)
+    }
+
+    private static let pressureWearStateDidChange: callbackWearState = { context, state in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.pressureWearStateDidChange(self_, wearState: WearState(wearState: state))
+    }
+
+    private static let didDetect: callback_function = { context, exercise in
+        guard let context else { return }
+        if exercise == AidlabSDK.exerciseNone { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didDetectExercise(self_, exercise: Exercise(exercise: exercise))
+    }
+
+    private static let didDetectActivity: callbackActivity = { context, timestamp, activity in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.activity) else { return }
+        self_.account(.activity)
+        self_.decodingSession?.delegate?.didReceiveActivity(self_, timestamp: timestamp, activity: ActivityType(activityType: activity))
+    }
+
+    private static let didReceivePayload: callbackPayload = { context, process, payload, payloadLength, options in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+
+        let processString = process.map { String(cString: $0) } ?? "unknown"
+
+        let rawPayload = if let payload, payloadLength > 0 {
+            Data(bytes: payload, count: Int(payloadLength))
+        } else {
+            Data()
+        }
+
+        self_.handleProcessCommandPayload(process: processString, payload: rawPayload)
+        self_.decodingSession?.delegate?.didReceivePayload(self_, process: processString, payload: rawPayload, options: options)
+    }
+
+    private static let didReceiveProcessError: callbackProcessError = { context, process, pid, payload, payloadLength, options in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        let processString = process.map { String(cString: $0) } ?? "unknown"
+        let rawPayload = if let payload, payloadLength > 0 {
+            Data(bytes: payload, count: Int(payloadLength))
+        } else {
+            Data()
+        }
+        self_.decodingSession?.delegate?.didReceiveProcessError(
+            self_, process: processString, pid: pid, payload: rawPayload, options: options
+        )
+    }
+
+    private static let didDetectUserEvent: callbackUserEvent = { context, timestamp in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didDetectUserEvent(self_, timestamp: timestamp)
+    }
+
+    private static let didReceiveError: callbackError = { context, code, text in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+
+        guard let cStringPointer = text,
+              let string = String(validatingCString: cStringPointer)
+        else { return }
+
+        let error = AidlabError.fromCore(rawCode: Int32(code.rawValue), message: string)
+        self_.statisticsCollector.recordProtocolError()
+        self_.completeFrameConfirmation(error: error)
+        self_.decodingSession?.delegate?.didReceiveError(self_, error: error)
+    }
+
+    private static let didReceiveSignalQuality: callbackSignalQuality = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didReceiveSignalQuality(self_, timestamp: timestamp, value: Int32(value))
+    }
+
+    private static let didReceiveBatteryLevel: callbackBatteryLevel = { context, stateOfCharge in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didReceiveBatteryLevel(self_, stateOfCharge: stateOfCharge)
+    }
+
+    private static let didReceiveSteps: callbackSteps = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.steps) else { return }
+        self_.account(.steps)
+        self_.decodingSession?.delegate?.didReceiveSteps(self_, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastECG: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.ecg) else { return }
+        self_.account(.ecg)
+        self_.bufferSample(self_.pastECGSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastRespiration: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.respiration) else { return }
+        self_.account(.respiration)
+        self_.bufferSample(self_.pastRespirationSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastSkinTemperature: callbackSampleTime = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.skinTemperature) else { return }
+        self_.account(.skinTemperature)
+        self_.bufferSample(self_.pastSkinTemperatureSamples, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastHeartRate: callbackHeartRate = { context, timestamp, heartRate in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.heartRate) else { return }
+        self_.account(.heartRate)
+        self_.decodingSession?.delegate?.didReceivePastHeartRate(self_, timestamp: timestamp, heartRate: heartRate)
+    }
+
+    private static let syncStateDidChange: callbackSyncState = { context, state in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        let syncState = SyncState(syncState: state)
+        if syncState != .start {
+            self_.flushPastSampleBlocks(minimumCount: 1)
+        }
+        self_.decodingSession?.delegate?.syncStateDidChange(self_, state: syncState)
+    }
+
+    private static let didReceiveUnsynchronizedSize: callbackUnsynchronizedSize = { context, unsynchronizedSize, syncBytesPerSecond in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didReceiveUnsynchronizedSize(self_, unsynchronizedSize: unsynchronizedSize, syncBytesPerSecond: syncBytesPerSecond)
+    }
+
+    private static let didReceivePastRespirationRate: callbackRespirationRate = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.respirationRate) else { return }
+        self_.account(.respirationRate)
+        self_.decodingSession?.delegate?.didReceivePastRespirationRate(self_, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastActivity: callbackActivity = { context, timestamp, activity in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.activity) else { return }
+        self_.account(.activity)
+        self_.decodingSession?.delegate?.didReceivePastActivity(self_, timestamp: timestamp, activity: ActivityType(activityType: activity))
+    }
+
+    private static let didReceivePastSteps: callbackSteps = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.steps) else { return }
+        self_.account(.steps)
+        self_.decodingSession?.delegate?.didReceivePastSteps(self_, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastRr: callbackRr = { context, timestamp, rr in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.rr) else { return }
+        self_.account(.rr)
+        self_.decodingSession?.delegate?.didReceivePastRr(self_, timestamp: timestamp, rr: rr)
+    }
+
+    private static let didReceivePastSoundVolume: callbackSoundVolume = { context, timestamp, soundVolume in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.soundVolume) else { return }
+        self_.account(.soundVolume)
+        self_.decodingSession?.delegate?.didReceivePastSoundVolume(self_, timestamp: timestamp, soundVolume: soundVolume)
+    }
+
+    private static let didReceivePastPressure: callbackPressure = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.pressure) else { return }
+        self_.account(.pressure)
+        self_.decodingSession?.delegate?.didReceivePastPressure(self_, timestamp: timestamp, value: value)
+    }
+
+    private static let didReceivePastAccelerometer: callbackAccelerometer = { context, timestamp, ax, ay, az in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.pastAccelerometerSamples, timestamp: timestamp, x: ax, y: ay, z: az)
+    }
+
+    private static let didReceivePastGyroscope: callbackGyroscope = { context, timestamp, gx, gy, gz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.pastGyroscopeSamples, timestamp: timestamp, x: gx, y: gy, z: gz)
+    }
+
+    private static let didReceivePastQuaternion: callbackQuaternion = { context, timestamp, qw, qx, qy, qz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.pastQuaternionSamples, timestamp: timestamp, w: qw, x: qx, y: qy, z: qz)
+    }
+
+    private static let didReceivePastOrientation: callbackOrientation = { context, timestamp, roll, pitch, yaw in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.orientation) else { return }
+        self_.account(.orientation)
+        self_.decodingSession?.delegate?.didReceivePastOrientation(self_, timestamp: timestamp, roll: roll, pitch: pitch, yaw: yaw)
+    }
+
+    private static let didReceivePastEDA: callbackEda = { context, timestamp, conductance in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.eda) else { return }
+        self_.account(.eda)
+        self_.decodingSession?.delegate?.didReceivePastEDA(self_, timestamp: timestamp, conductance: conductance)
+    }
+
+    private static let didReceivePastGPS: callbackGps = { context, timestamp, latitude, longitude, altitude, speed, heading, hdop in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.gps) else { return }
+        self_.account(.gps)
+        self_.decodingSession?.delegate?.didReceivePastGPS(self_,
+                                                timestamp: timestamp,
+                                                latitude: Double(latitude),
+                                                longitude: Double(longitude),
+                                                altitude: Double(altitude),
+                                                speed: speed,
+                                                heading: heading,
+                                                hdop: hdop)
+    }
+
+    private static let didReceivePastMagnetometer: callbackMagnetometer = { context, timestamp, mx, my, mz in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.motion) else { return }
+        self_.account(.motion)
+        self_.bufferSample(self_.pastMagnetometerSamples, timestamp: timestamp, x: mx, y: my, z: mz)
+    }
+
+    private static let didReceivePastBodyPosition: callbackBodyPosition = { context, timestamp, bodyPosition in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        guard self_.isEnabled(.bodyPosition) else { return }
+        self_.account(.bodyPosition)
+        self_.decodingSession?.delegate?.didReceivePastBodyPosition(self_, timestamp: timestamp, bodyPosition: BodyPosition(bodyPosition: bodyPosition))
+    }
+
+    private static let didDetectPastUserEvent: callbackUserEvent = { context, timestamp in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didDetectPastUserEvent(self_, timestamp: timestamp)
+    }
+
+    private static let didReceivePastSignalQuality: callbackSignalQuality = { context, timestamp, value in
+        guard let context else { return }
+        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
+        self_.decodingSession?.delegate?.didReceivePastSignalQuality(self_, timestamp: timestamp, value: UInt8(value))
+    }
+}
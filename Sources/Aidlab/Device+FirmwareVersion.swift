@@ -6,32 +6,8 @@
 import Foundation
 
 extension Device {
-    func usesV4Protocol() -> Bool {
-        guard let firmwareRevision else { return false }
-        let sanitized = firmwareRevision.split(separator: "-").first.map(String.init) ?? firmwareRevision
-        guard let current = SemVersion(sanitized),
-              let threshold = SemVersion("4.0.0")
-        else { return false }
-        return current >= threshold
-    }
-
-    func hasCollectAutoSyncBug() -> Bool {
-        guard let firmwareRevision else { return false }
-        let sanitized = firmwareRevision.split(separator: "-").first.map(String.init) ?? firmwareRevision
-        guard let current = SemVersion(sanitized),
-              let firstAffected = SemVersion("3.7.85"),
-              let lastAffected = SemVersion("3.7.110")
-        else { return false }
-        return current >= firstAffected && current <= lastAffected
-    }
-
     func synchronizationStartCommand() -> String {
-        guard let firmwareRevision else { return "sync start" }
-        let sanitized = firmwareRevision.split(separator: "-").first.map(String.init) ?? firmwareRevision
-        guard let current = SemVersion(sanitized),
-              let firstFastVersion = SemVersion("3.7.83")
-        else { return "sync start" }
-        return current >= firstFastVersion ? "sync fast" : "sync start"
+        capabilities.supportsFastSync ? "sync fast" : "sync start"
     }
 
     func commandBytes(_ command: String) -> [UInt8] {
@@ -48,6 +24,12 @@ struct SemVersion: Comparable {
     let minor: Int
     let patch: Int
 
+    init(_ major: Int, _ minor: Int, _ patch: Int) {
+        self.major = major
+        self.minor = minor
+        self.patch = patch
+    }
+
     init?(_ version: String) {
         let parts = version.split(separator: ".").compactMap { Int($0) }
         guard parts.count == 3 else { return nil }
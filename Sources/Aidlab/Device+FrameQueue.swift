@@ -0,0 +1,366 @@
+import AidlabSDK
+import Foundation
+
+final class FrameConfirmation: @unchecked Sendable {
+    private let lock = NSLock()
+    private var result: Result<Void, Error>?
+    private var continuation: CheckedContinuation<Void, Error>?
+
+    func finish(_ result: Result<Void, Error>) {
+        lock.lock()
+        guard self.result == nil else {
+            lock.unlock()
+            return
+        }
+        self.result = result
+        let continuation = continuation
+        self.continuation = nil
+        lock.unlock()
+        continuation?.resume(with: result)
+    }
+
+    func wait() async throws {
+        try await withCheckedThrowingContinuation { continuation in
+            lock.lock()
+            if let result {
+                lock.unlock()
+                continuation.resume(with: result)
+                return
+            }
+            self.continuation = continuation
+            lock.unlock()
+        }
+    }
+}
+
+extension Device {
+    enum QueuedSend {
+        case frame(bytes: [UInt8], processId: Int)
+        /// A process command waiting for its turn, resumed once it owns the frame confirmation.
+        case command(CheckedContinuation<FrameConfirmation, Error>)
+    }
+
+    func submitSend(_ bytes: [UInt8], processId: Int) {
+        guard beginFrameConfirmation() != nil else {
+            deviceDelegate?.didReceiveError(
+                self,
+                error: AidlabError(message: "Previous BLE frame is not confirmed")
+            )
+            return
+        }
+        emitSend(bytes, processId: processId)
+    }
+
+    /// Emits one `send()` payload; the caller already owns the frame confirmation.
+    private func emitSend(_ bytes: [UInt8], processId: Int) {
+        guard session != nil else {
+            completeFrameConfirmation(error: AidlabError(message: "Device is not connected"))
+            return
+        }
+        emitTrackedFrame({ aidlabSDK in
+            var payload = bytes
+            AidlabSDK_send(&payload, Int32(payload.count), Int32(processId), aidlabSDK)
+        }, completion: { [self] error in
+            if let error {
+                failFrameTransmission(error)
+            }
+        })
+    }
+
+    func sendRawBleData(_ frame: Data, completesFrame: Bool) {
+        guard !frame.isEmpty else { return }
+
+        chunkQueue.enqueueFrame(frame, chunkSize: resolvedChunkSize(), completesFrame: completesFrame)
+        drainChunkQueue()
+    }
+
+    private func resolvedChunkSize() -> Int {
+        guard capabilities.usesV4Protocol else {
+            return 20
+        }
+
+        let negotiated = transport.mtuSize
+        if negotiated > 0 {
+            return min(maxCmdPackageLength, max(20, negotiated))
+        }
+        return 20
+    }
+
+    private func chunkWriteCredits() -> Int {
+        capabilities.usesV4Protocol ? max(1, transport.writeWithoutResponseCredits) : 1
+    }
+
+    func resetBleQueue() {
+        chunkQueue.removeAll()
+        chunkWritesInFlight = 0
+        chunkWriteGeneration &+= 1
+        completeFrameConfirmation(error: AidlabError(message: "BLE frame was reset"))
+    }
+
+    private func beginFrameConfirmation() -> FrameConfirmation? {
+        frameConfirmationLock.lock()
+        guard !awaitingFrameConfirmation else {
+            frameConfirmationLock.unlock()
+            return nil
+        }
+        let (confirmation, previousDeadline) = beginFrameConfirmationLocked()
+        frameConfirmationLock.unlock()
+        previousDeadline?.cancel()
+        return confirmation
+    }
+
+    /// Waits behind queued `send()` payloads and commands until the next frame may go out, then owns its confirmation.
+    func acquireFrameConfirmation() async throws -> FrameConfirmation {
+        try await withCheckedThrowingContinuation { continuation in
+            frameConfirmationLock.lock()
+            if awaitingFrameConfirmation || !queuedSends.isEmpty {
+                guard queuedSends.count < maxQueuedFrames else {
+                    frameConfirmationLock.unlock()
+                    continuation.resume(throwing: AidlabError(message: "BLE send queue is full"))
+                    return
+                }
+                queuedSends.append(.command(continuation))
+                frameConfirmationLock.unlock()
+                return
+            }
+            let (confirmation, previousDeadline) = beginFrameConfirmationLocked()
+            frameConfirmationLock.unlock()
+            previousDeadline?.cancel()
+            continuation.resume(returning: confirmation)
+        }
+    }
+
+    /// Caller holds `frameConfirmationLock` and has checked that no frame awaits confirmation; it cancels the
+    /// returned deadline after unlocking.
+    private func beginFrameConfirmationLocked() -> (FrameConfirmation, DispatchWorkItem?) {
+        let confirmation = FrameConfirmation()
+        awaitingFrameConfirmation = true
+        currentFrameConfirmation = confirmation
+        frameConfirmationGeneration &+= 1
+        let previousDeadline = frameConfirmationDeadline
+        frameConfirmationDeadline = nil
+        return (confirmation, previousDeadline)
+    }
+
+    /// Runs `action` on the session's instance, in order with the chunks it decodes, and reports whether it
+    /// emitted a frame: `nil` if it did, otherwise why not. With an engine `action` runs on the worker later and
+    /// `completion` on the transport queue; nothing waits for either.
+    func emitTrackedFrame(
+        _ action: @escaping @Sendable (UnsafeMutableRawPointer) -> Void,
+        completion: @escaping @Sendable (AidlabError?) -> Void
+    ) {
+        guard let session else {
+            completion(AidlabError(message: "Device is not connected"))
+            return
+        }
+        session.useInstance { [self] aidlabSDK in
+            let error: AidlabError? = if let aidlabSDK {
+                emitTrackedFrame(action, on: aidlabSDK) ? nil : AidlabError(message: "SDK rejected the BLE frame")
+            } else {
+                AidlabError(message: "Device is not connected")
+            }
+            if let transportQueue = session.transportQueue {
+                transportQueue.async { completion(error) }
+            } else {
+                completion(error)
+            }
+        }
+    }
+
+    func emitTrackedFrame(
+        _ action: (UnsafeMutableRawPointer) -> Void,
+        on aidlabSDK: UnsafeMutableRawPointer
+    ) -> Bool {
+        let thread = ObjectIdentifier(Thread.current)
+        frameConfirmationLock.lock()
+        expectedFrameCallbackThread = thread
+        frameConfirmationLock.unlock()
+
+        action(aidlabSDK)
+
+        frameConfirmationLock.lock()
+        let emitted = expectedFrameCallbackThread != thread
+        if !emitted {
+            expectedFrameCallbackThread = nil
+        }
+        frameConfirmationLock.unlock()
+        return emitted
+    }
+
+    func consumeTrackedFrameCallback() -> Bool {
+        let thread = ObjectIdentifier(Thread.current)
+        frameConfirmationLock.lock()
+        let tracked = expectedFrameCallbackThread == thread
+        if tracked {
+            expectedFrameCallbackThread = nil
+        }
+        frameConfirmationLock.unlock()
+        return tracked
+    }
+
+    private func armFrameConfirmationDeadline() {
+        if !capabilities.usesV4Protocol {
+            completeFrameConfirmation()
+            return
+        }
+
+        frameConfirmationLock.lock()
+        guard awaitingFrameConfirmation else {
+            frameConfirmationLock.unlock()
+            return
+        }
+
+        frameConfirmationGeneration &+= 1
+        let generation = frameConfirmationGeneration
+        let previousDeadline = frameConfirmationDeadline
+        let deadline = DispatchWorkItem { [weak self] in
+            self?.frameConfirmationDidTimeout(generation: generation)
+        }
+        frameConfirmationDeadline = deadline
+        frameConfirmationLock.unlock()
+
+        previousDeadline?.cancel()
+        DispatchQueue.main.asyncAfter(
+            deadline: .now() + Device.frameConfirmationTimeout,
+            execute: deadline
+        )
+    }
+
+    /// Ends the frame awaiting confirmation. A failed frame leaves the session unreliable, so unless
+    /// `keepsQueuedSends` is set (for commands abandoned before they emitted anything) every queued send and
+    /// command fails with the same error instead of going out.
+    func completeFrameConfirmation(error: Error? = nil, keepsQueuedSends: Bool = false) {
+        frameConfirmationLock.lock()
+        awaitingFrameConfirmation = false
+        frameConfirmationGeneration &+= 1
+        let deadline = frameConfirmationDeadline
+        let confirmation = currentFrameConfirmation
+        frameConfirmationDeadline = nil
+        currentFrameConfirmation = nil
+        expectedFrameCallbackThread = nil
+        var droppedSends: [QueuedSend] = []
+        if error != nil, !keepsQueuedSends {
+            droppedSends = queuedSends
+            queuedSends.removeAll()
+        }
+        let hasQueuedSends = !queuedSends.isEmpty
+        frameConfirmationLock.unlock()
+        deadline?.cancel()
+        if let error {
+            confirmation?.finish(.failure(error))
+        } else {
+            confirmation?.finish(.success(()))
+        }
+        if let error, !droppedSends.isEmpty {
+            failQueuedSends(droppedSends, error: error)
+        }
+        if hasQueuedSends {
+            // Confirmation usually arrives from inside the SDK; the next frame must not re-enter it from there.
+            DispatchQueue.main.async { [weak self] in
+                self?.submitNextQueuedSend()
+            }
+        }
+    }
+
+    private func submitNextQueuedSend() {
+        frameConfirmationLock.lock()
+        guard !awaitingFrameConfirmation, !queuedSends.isEmpty else {
+            frameConfirmationLock.unlock()
+            return
+        }
+        let next = queuedSends.removeFirst()
+        let (confirmation, previousDeadline) = beginFrameConfirmationLocked()
+        frameConfirmationLock.unlock()
+        previousDeadline?.cancel()
+        switch next {
+        case let .frame(bytes, processId):
+            emitSend(bytes, processId: processId)
+        case let .command(continuation):
+            continuation.resume(returning: confirmation)
+        }
+    }
+
+    /// Commands throw `error`; each dropped `send()` payload is reported to the delegate on the main thread.
+    private func failQueuedSends(_ sends: [QueuedSend], error: Error) {
+        var droppedFrames = 0
+        for send in sends {
+            switch send {
+            case .frame: droppedFrames += 1
+            case let .command(continuation): continuation.resume(throwing: error)
+            }
+        }
+        guard droppedFrames > 0 else { return }
+        let error = AidlabError.wrapping(error)
+        DispatchQueue.main.async { [weak self] in
+            guard let self else { return }
+            for _ in 0 ..< droppedFrames {
+                deviceDelegate?.didReceiveError(self, error: error)
+            }
+        }
+    }
+
+    func failFrameTransmission(_ error: AidlabError) {
+        statisticsCollector.recordTransportError()
+        chunkQueue.removeAll()
+        chunkWritesInFlight = 0
+        chunkWriteGeneration &+= 1
+        completeFrameConfirmation(error: error)
+        deviceDelegate?.didReceiveError(self, error: error)
+        transport.disconnect()
+    }
+
+    private func frameConfirmationDidTimeout(generation: UInt64) {
+        frameConfirmationLock.lock()
+        guard awaitingFrameConfirmation, frameConfirmationGeneration == generation else {
+            frameConfirmationLock.unlock()
+            return
+        }
+        frameConfirmationLock.unlock()
+        failFrameTransmission(AidlabError(message: "BLE frame confirmation timed out"))
+    }
+
+    func drainChunkQueue() {
+        let credits = chunkWriteCredits()
+        while chunkWritesInFlight < credits, let chunk = chunkQueue.popFirst() {
+            chunkWritesInFlight += 1
+            writeChunk(chunk, generation: chunkWriteGeneration)
+        }
+    }
+
+    private func writeChunk(_ chunk: BLEChunkQueue.Chunk, generation: UInt64) {
+        #if AIDLAB_TRACING
+            let writeTrace = tracer.map { ($0, $0.begin(.characteristicWrite)) }
+        #endif
+        transport.writeCharacteristic(
+            cmdCharacteristicUUID,
+            data: chunk.data,
+            withResponse: !capabilities.usesV4Protocol
+        ) { [weak self] result in
+            #if AIDLAB_TRACING
+                if let writeTrace {
+                    writeTrace.0.end(.characteristicWrite, token: writeTrace.1)
+                }
+            #endif
+            guard let self, generation == chunkWriteGeneration else { return }
+            switch result {
+            case .success:
+                handleCommandWriteResult(error: nil, completesFrame: chunk.completesFrame)
+            case let .failure(error):
+                handleCommandWriteResult(error: error, completesFrame: chunk.completesFrame)
+            }
+        }
+    }
+
+    func handleCommandWriteResult(error: Error?, completesFrame: Bool) {
+        chunkWritesInFlight -= 1
+        if let error {
+            failFrameTransmission(AidlabError.wrapping(error))
+            return
+        }
+
+        if completesFrame {
+            armFrameConfirmationDeadline()
+        }
+        drainChunkQueue()
+    }
+}
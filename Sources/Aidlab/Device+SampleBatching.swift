@@ -0,0 +1,145 @@
+import Foundation
+
+extension Device {
+    /// Defers per-sample callbacks fired by the SDK inside `body` and delivers them as one block per signal.
+    /// The chunk is accounted in `statistics`, and `receivedAt` is the reference for `latency`.
+    func withSampleBatching(byteCount: Int, receivedAt: UInt64, _ body: () -> Void) {
+        chunkReceivedAt = receivedAt
+        let start = DispatchTime.now().uptimeNanoseconds
+        isBatchingSamples = true
+        traced(.chunkDecode, body)
+        isBatchingSamples = false
+        let decoded = DispatchTime.now().uptimeNanoseconds
+        traced(.sampleDelivery, flushSampleBlocks)
+        statisticsCollector.recordChunk(
+            byteCount: byteCount,
+            decodeNanoseconds: decoded - start,
+            callbackNanoseconds: DispatchTime.now().uptimeNanoseconds - decoded
+        )
+    }
+
+    /// Runs `body` as a `tracer` interval; a plain call unless built with `AIDLAB_TRACING`.
+    @inline(__always)
+    func traced<T>(_ event: TraceEvent, _ body: () -> T) -> T {
+        #if AIDLAB_TRACING
+            if let tracer = decodingSession?.settings.tracer {
+                let token = tracer.begin(event)
+                defer { tracer.end(event, token: token) }
+                return body()
+            }
+        #endif
+        return body()
+    }
+
+    /// Gate at the top of every data callback: types masked out by `enabledDataTypes` return before any work.
+    func isEnabled(_ dataType: DataType) -> Bool {
+        decodingSession?.settings.enabledDataTypes.contains(DataTypeMask(dataType)) == true
+    }
+
+    /// Counts one sample or event that passed `isEnabled` and, for types not delivered as blocks, records its
+    /// latency. Blocks are timed when they are flushed.
+    func account(_ dataType: DataType) {
+        statisticsCollector.countSample(dataType)
+        if decodingSession?.settings.measuresLatency == true, !LatencyRecorder.blockDataTypes.contains(DataTypeMask(dataType)) {
+            latencyRecorder.record(dataType, receivedAt: chunkReceivedAt)
+        }
+    }
+
+    func bufferSample(_ buffer: SampleBlockBuffer, timestamp: UInt64, value: Float) {
+        markFirstReceipt(of: buffer)
+        buffer.append(timestamp, value)
+        if !isBatchingSamples {
+            flushSampleBlocks()
+        }
+    }
+
+    func bufferSample(_ buffer: SampleBlockBuffer, timestamp: UInt64, x: Float, y: Float, z: Float) {
+        markFirstReceipt(of: buffer)
+        buffer.append(timestamp, x, y, z)
+        if !isBatchingSamples {
+            flushSampleBlocks()
+        }
+    }
+
+    func bufferSample(_ buffer: SampleBlockBuffer, timestamp: UInt64, w: Float, x: Float, y: Float, z: Float) {
+        markFirstReceipt(of: buffer)
+        buffer.append(timestamp, w, x, y, z)
+        if !isBatchingSamples {
+            flushSampleBlocks()
+        }
+    }
+
+    /// A paged block spans several chunks; its latency is measured from the earliest of them.
+    @inline(__always)
+    private func markFirstReceipt(of buffer: SampleBlockBuffer) {
+        if buffer.isEmpty {
+            buffer.firstReceivedAt = chunkReceivedAt
+        }
+    }
+
+    private func flushSampleBlocks() {
+        flushLiveSampleBlocks()
+        flushPastSampleBlocks(minimumCount: max(1, decodingSession?.settings.synchronizationPageSize ?? 1))
+    }
+
+    private func flushLiveSampleBlocks() {
+        let delegate = decodingSession?.delegate
+        flush(ecgSamples, as: .ecg) { delegate?.didReceiveECG(self, samples: $0.block) }
+        flush(respirationSamples, as: .respiration) { delegate?.didReceiveRespiration(self, samples: $0.block) }
+        flush(skinTemperatureSamples, as: .skinTemperature) { delegate?.didReceiveSkinTemperature(self, samples: $0.block) }
+        flush(accelerometerSamples, as: .accelerometer) { delegate?.didReceiveAccelerometer(self, samples: $0.vectorBlock) }
+        flush(gyroscopeSamples, as: .gyroscope) { delegate?.didReceiveGyroscope(self, samples: $0.vectorBlock) }
+        flush(magnetometerSamples, as: .magnetometer) { delegate?.didReceiveMagnetometer(self, samples: $0.vectorBlock) }
+        flush(quaternionSamples, as: .quaternion) { delegate?.didReceiveQuaternion(self, samples: $0.quaternionBlock) }
+    }
+
+    func flushPastSampleBlocks(minimumCount: Int) {
+        let delegate = decodingSession?.delegate
+        flush(pastECGSamples, as: .pastECG, minimumCount: minimumCount) { delegate?.didReceivePastECG(self, samples: $0.block) }
+        flush(pastRespirationSamples, as: .pastRespiration, minimumCount: minimumCount) { delegate?.didReceivePastRespiration(self, samples: $0.block) }
+        flush(pastSkinTemperatureSamples, as: .pastSkinTemperature, minimumCount: minimumCount) { delegate?.didReceivePastSkinTemperature(self, samples: $0.block) }
+        flush(pastAccelerometerSamples, as: .pastAccelerometer, minimumCount: minimumCount) { delegate?.didReceivePastAccelerometer(self, samples: $0.vectorBlock) }
+        flush(pastGyroscopeSamples, as: .pastGyroscope, minimumCount: minimumCount) { delegate?.didReceivePastGyroscope(self, samples: $0.vectorBlock) }
+        flush(pastMagnetometerSamples, as: .pastMagnetometer, minimumCount: minimumCount) { delegate?.didReceivePastMagnetometer(self, samples: $0.vectorBlock) }
+        flush(pastQuaternionSamples, as: .pastQuaternion, minimumCount: minimumCount) { delegate?.didReceivePastQuaternion(self, samples: $0.quaternionBlock) }
+    }
+
+    private func flush(
+        _ buffer: SampleBlockBuffer,
+        as signal: WaveformSignal,
+        minimumCount: Int = 1,
+        _ deliver: (SampleBlockBuffer) -> Void
+    ) {
+        guard buffer.count >= minimumCount, let session = decodingSession else { return }
+        let settings = session.settings
+        streamClocks[signal, default: StreamClock(signal: signal)].observe(
+            buffer.timestampColumn,
+            reportsChanges: settings.reportsStreamDescriptors
+        ) {
+            session.delegate?.streamDescriptorDidChange(self, descriptor: $0)
+        }
+        settings.recorder?.record(signal, buffer)
+        if settings.measuresLatency {
+            latencyRecorder.record(signal.dataType, receivedAt: buffer.firstReceivedAt)
+        }
+        if let ring = settings.sampleRings?[signal] {
+            ring.push(buffer)
+        } else {
+            deliver(buffer)
+        }
+        buffer.removeAll()
+    }
+
+    /// Drops samples still buffered when a new session starts. A session's teardown normally delivers them, so
+    /// anything left here belongs to a session that ended without one.
+    func discardSampleBlocks() {
+        for buffer in [
+            ecgSamples, respirationSamples, skinTemperatureSamples,
+            accelerometerSamples, gyroscopeSamples, magnetometerSamples, quaternionSamples,
+            pastECGSamples, pastRespirationSamples, pastSkinTemperatureSamples,
+            pastAccelerometerSamples, pastGyroscopeSamples, pastMagnetometerSamples, pastQuaternionSamples
+        ] {
+            buffer.removeAll()
+        }
+    }
+}
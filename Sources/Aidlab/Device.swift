@@ -7,43 +7,6 @@ import AidlabSDK
 @preconcurrency import CoreBluetooth
 import Foundation
 
-private final class FrameConfirmation: @unchecked Sendable {
-    private let lock = NSLock()
-    private var result: Result<Void, Error>?
-    private var continuation: CheckedContinuation<Void, Error>?
-
-    func finish(_ result: Result<Void, Error>) {
-        lock.lock()
-        guard self.result == nil else {
-            lock.unlock()
-            return
-        }
-        self.result = result
-        let continuation = continuation
-        self.continuation = nil
-        lock.unlock()
-        continuation?.resume(with: result)
-    }
-
-    func wait() async throws {
-        try await withCheckedThrowingContinuation { continuation in
-            lock.lock()
-            if let result {
-                lock.unlock()
-                continuation.resume(with: result)
-                return
-            }
-            self.continuation = continuation
-            lock.unlock()
-        }
-    }
-}
-
-private struct QueuedBLEChunk {
-    let data: Data
-    let completesFrame: Bool
-}
-
 private actor ProcessCommandGate {
     private var isLocked = false
     private var waiters: [CheckedContinuation<Void, Never>] = []
@@ -76,10 +39,15 @@ public class Device: NSObject, @unchecked Sendable {
     private static let systemKillFailure: UInt8 = 3
     private static let syncProcessId: UInt8 = 7
     private static let collectProcessId: UInt8 = 8
-    private static let frameConfirmationTimeout: TimeInterval = 3
+    static let frameConfirmationTimeout: TimeInterval = 3
 
     public var name: String?
-    public var firmwareRevision: String?
+    public var firmwareRevision: String? {
+        didSet { capabilities = FirmwareCapabilities(revision: firmwareRevision) }
+    }
+
+    /// Features of `firmwareRevision`, parsed once whenever it changes.
+    public private(set) var capabilities = FirmwareCapabilities.unknown
     public var hardwareRevision: String?
     public var serialNumber: String?
     public var manufacturerName: String?
@@ -89,6 +57,94 @@ public class Device: NSObject, @unchecked Sendable {
         set { transport.rssi = newValue }
     }
 
+    /// Decode worker pool shared with other devices. Set before `connect`; it applies from the next connection.
+    public var decodeEngine: DecodeEngine?
+
+    /// Bulk synchronization mode: collect this many past samples per signal before delivering them as one block.
+    /// `nil` delivers past samples once per decoded chunk, like live data. Partial pages are delivered before
+    /// `syncStateDidChange` reports that synchronization ended or stopped, and when the connection ends.
+    public var synchronizationPageSize: Int? {
+        didSet { updateSession { [synchronizationPageSize] in $0.synchronizationPageSize = synchronizationPageSize } }
+    }
+
+    /// Records raw inbound chunks and outbound frames while set. See `ChunkCapture.replay(delegate:)`.
+    public var capture: ChunkCapture? {
+        didSet { updateSession { [capture] in $0.capture = capture } }
+    }
+
+    /// Writes every decoded waveform block to a columnar file while set. See `SignalRecording` for reading it back.
+    public var recorder: SignalRecorder? {
+        didSet { updateSession { [recorder] in $0.recorder = recorder } }
+    }
+
+    /// While set, sample blocks of the signals it has rings for are pushed into them instead of the delegate's block
+    /// callbacks, so a slow consumer drains them on its own thread without holding up BLE delivery. Other signals
+    /// and events are still delivered to the delegate. Watch `SampleRings.overflowCount` for samples dropped because
+    /// a ring was full.
+    public var sampleRings: SampleRings? {
+        didSet { updateSession { [sampleRings] in $0.sampleRings = sampleRings } }
+    }
+
+    /// Tracks the implicit clock of every waveform signal and reports it through
+    /// `DeviceDelegate.streamDescriptorDidChange(_:descriptor:)`: when a stream starts or reporting is turned on,
+    /// and again on dropped samples or clock corrections. Sample indices count from the start of the connection
+    /// either way.
+    public var reportsStreamDescriptors = false {
+        didSet { updateSession { [reportsStreamDescriptors] in $0.reportsStreamDescriptors = reportsStreamDescriptors } }
+    }
+
+    /// Data types delivered to the delegate. Callbacks for other types return before any buffering or
+    /// dispatch, and `collect` does not ask the device to stream them live. Set it before `connect`.
+    public var enabledDataTypes: DataTypeMask = .all {
+        didSet { updateSession { [enabledDataTypes] in $0.enabledDataTypes = enabledDataTypes } }
+    }
+
+    /// Current and peak bytes held by this device's sample block buffers. Memory allocated inside the SDK
+    /// instance is not included.
+    var memoryFootprint: MemoryFootprint {
+        sampleMemory.currentFootprint
+    }
+
+    /// Creates the SDK instance for the next connection as soon as this one ends, so that a reconnect with
+    /// unchanged firmware starts decoding without creating and registering a new instance. Costs one idle
+    /// instance while disconnected.
+    public var preparesReconnect = false
+
+    /// Payloads `send(_:processId:)` and process commands such as `collect` or `sync` hold while the previous frame
+    /// awaits confirmation. Beyond this, `send` reports an error and commands throw instead of queueing. When a
+    /// frame fails, everything queued fails with it.
+    public var maxQueuedFrames = 16
+
+    /// Decoder and link counters, safe to read from any thread.
+    public var statistics: DeviceStatistics {
+        statisticsCollector.snapshot
+    }
+
+    public func resetStatistics() {
+        statisticsCollector.reset()
+    }
+
+    /// Receives the trace points on the decode and send paths. They are compiled in only when the package is
+    /// built with `AIDLAB_TRACING=1`; see `AidlabTracer`.
+    public var tracer: AidlabTracer? {
+        didSet { updateSession { [tracer] in $0.tracer = tracer } }
+    }
+
+    /// Records, per data type, the time from a notification arriving at the device to its data reaching the
+    /// delegate: per event for scalar types and per block for waveforms. A synchronization page counts from the
+    /// first chunk that contributed to it. Read the results with `latency`.
+    public var measuresLatency = false {
+        didSet { updateSession { [measuresLatency] in $0.measuresLatency = measuresLatency } }
+    }
+
+    public var latency: [DataType: LatencySummary] {
+        latencyRecorder.summaries
+    }
+
+    public func resetLatency() {
+        latencyRecorder.reset()
+    }
+
     let transport: AidlabTransport
     private var activeNotificationUUIDs: Set<CBUUID> = []
     private var legacyCollectionNotificationUUIDs: Set<CBUUID> = []
@@ -103,10 +159,31 @@ public class Device: NSObject, @unchecked Sendable {
         (transport as? CoreBluetoothAidlabTransport)?.peripheral
     }
 
-    public init(transport: AidlabTransport) {
+    public convenience init(transport: AidlabTransport) {
+        self.init(transport: transport, allocator: SystemSampleAllocator.shared)
+    }
+
+    /// - Parameter allocator: Backs the sample block buffers; see `memoryFootprint`.
+    init(transport: AidlabTransport, allocator: SampleAllocator) {
         self.transport = transport
         address = transport.address
         name = transport.name
+        let memory = SampleMemory(allocator: allocator)
+        sampleMemory = memory
+        ecgSamples = SampleBlockBuffer(memory: memory)
+        respirationSamples = SampleBlockBuffer(memory: memory)
+        skinTemperatureSamples = SampleBlockBuffer(memory: memory)
+        pastECGSamples = SampleBlockBuffer(memory: memory)
+        pastRespirationSamples = SampleBlockBuffer(memory: memory)
+        pastSkinTemperatureSamples = SampleBlockBuffer(memory: memory)
+        accelerometerSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        gyroscopeSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        magnetometerSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        quaternionSamples = SampleBlockBuffer(columnCount: 4, memory: memory)
+        pastAccelerometerSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        pastGyroscopeSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        pastMagnetometerSamples = SampleBlockBuffer(columnCount: 3, memory: memory)
+        pastQuaternionSamples = SampleBlockBuffer(columnCount: 4, memory: memory)
         super.init()
 
         if let coreBluetoothTransport = transport as? CoreBluetoothAidlabTransport {
@@ -117,6 +194,12 @@ public class Device: NSObject, @unchecked Sendable {
         }
     }
 
+    deinit {
+        if let spare = spareAidlabSDK {
+            Device.destroyInstance(spare.pointer)
+        }
+    }
+
     public convenience init(peripheral: CBPeripheral, rssi: NSNumber) {
         let defaultTransport =
             CoreBluetoothAidlabTransport(
@@ -168,15 +251,15 @@ public class Device: NSObject, @unchecked Sendable {
     }
 
     public func collect(dataTypes: [DataType], dataTypesToStore: [DataType]) async throws -> UInt16? {
-        guard aidlabSDK != nil else {
+        guard session != nil else {
             throw AidlabError(message: "API misuse: Attempt to use the API without an established connection. Please ensure the device is connected using the connect() method before invoking this API.")
         }
 
-        guard let firmwareRevision, let firmwareSemantic = SemVersion(firmwareRevision), let legacySemanticVersion = SemVersion("3.6.0") else {
+        guard capabilities.isRecognized else {
             throw AidlabError(message: "API misuse: Attempt to use the API without an established connection. Please ensure the device is connected using the connect() method before invoking this API.")
         }
 
-        if firmwareSemantic >= legacySemanticVersion {
+        if capabilities.supportsProcessCollection {
             // Build flags from signal arrays (use bit flags)
             var liveFlags: UInt32 = 0
             var syncFlags: UInt32 = 0
@@ -184,13 +267,14 @@ public class Device: NSObject, @unchecked Sendable {
             for signal in dataTypes {
                 liveFlags |= 1 << signal.rawValue
             }
+            liveFlags &= enabledDataTypes.rawValue
 
             for signal in dataTypesToStore {
                 syncFlags |= 1 << signal.rawValue
             }
 
             // Check firmware version to determine collect format
-            if let firmwareVersion3780 = SemVersion("3.7.80"), firmwareSemantic >= firmwareVersion3780 {
+            if capabilities.collectsWithFlagStrings {
                 // CollectSettingsString - newer firmware expects string format
                 let liveHex = String(format: "%08X", liveFlags)
                 let syncHex = String(format: "%08X", syncFlags)
@@ -198,7 +282,7 @@ public class Device: NSObject, @unchecked Sendable {
                 let activeCollectPid = activePid(for: Device.collectProcessId)
                 return try await sendProcessCommand(
                     commandBytes(collectCommand),
-                    spawnedProcessId: hasCollectAutoSyncBug() ? Device.syncProcessId : nil,
+                    spawnedProcessId: capabilities.hasCollectAutoSyncBug ? Device.syncProcessId : nil,
                     destinationPid: activeCollectPid ?? 0
                 )
             } else {
@@ -223,7 +307,7 @@ public class Device: NSObject, @unchecked Sendable {
             }
 
         } else { /// Legacy
-            startLegacyCollection(dataTypes: dataTypes)
+            startLegacyCollection(dataTypes: dataTypes.filter { enabledDataTypes.contains(DataTypeMask($0)) })
             return nil
         }
     }
@@ -253,13 +337,10 @@ public class Device: NSObject, @unchecked Sendable {
     }
 
     public func stopCollect() async throws -> UInt16? {
-        guard let firmwareRevision,
-              let firmware = SemVersion(firmwareRevision),
-              let processCollectionVersion = SemVersion("3.6.0")
-        else {
+        guard capabilities.isRecognized else {
             throw AidlabError(message: "Firmware revision is unavailable")
         }
-        if firmware < processCollectionVersion {
+        if !capabilities.supportsProcessCollection {
             stopLegacyCollection()
             return nil
         }
@@ -284,41 +365,77 @@ public class Device: NSObject, @unchecked Sendable {
     }
 
     /// Sends a raw payload to a runtime destination PID. Use processId 0 for shell/system commands.
+    ///
+    /// While a frame is waiting for confirmation, up to `maxQueuedFrames` payloads are queued and sent in order,
+    /// each as soon as the previous one is confirmed.
     public func send(_ bytes: [UInt8], processId: Int = 0) {
-        guard let aidlabSDK, !bytes.isEmpty else { return }
-        guard beginFrameConfirmation() != nil else {
-            deviceDelegate?.didReceiveError(
-                self,
-                error: AidlabError(message: "Previous BLE frame is not confirmed")
-            )
-            return
-        }
-        var payload = bytes
-        guard emitTrackedFrame({
-            AidlabSDK_send(&payload, Int32(payload.count), Int32(processId), aidlabSDK)
-        }) else {
-            failFrameTransmission(AidlabError(message: "SDK rejected the BLE frame"))
+        guard session != nil, !bytes.isEmpty else { return }
+        frameConfirmationLock.lock()
+        if awaitingFrameConfirmation || !queuedSends.isEmpty {
+            guard queuedSends.count < maxQueuedFrames else {
+                frameConfirmationLock.unlock()
+                deviceDelegate?.didReceiveError(self, error: AidlabError(message: "BLE send queue is full"))
+                return
+            }
+            queuedSends.append(.frame(bytes: bytes, processId: processId))
+            frameConfirmationLock.unlock()
             return
         }
+        frameConfirmationLock.unlock()
+        submitSend(bytes, processId: processId)
     }
 
     // -- Internal -------------------------------------------------------------
 
-    // Avoid implicitly unwrapped optional; use optional and guard when needed
-    var aidlabSDK: UnsafeMutableRawPointer?
+    /// The current connection's SDK instance and settings, as seen from the thread that drives the API.
+    private(set) var session: DecodeSession?
+    /// The last session handed to its teardown; the next one starts decoding after it has ended.
+    private var endingSession: DecodeSession?
+    /// The session whose instance is running. Only touched where sessions run, one at a time, so SDK callbacks
+    /// read their delegate and settings here without racing the main thread.
+    var decodingSession: DecodeSession?
+    /// Fresh instance made by `preparesReconnect`, tagged with the firmware revision it was created for.
+    private var spareAidlabSDK: (pointer: UnsafeMutableRawPointer, firmwareRevision: String)?
     var deviceDelegate: DeviceDelegate?
 
     var maxCmdPackageLength: Int = 20
 
     // BLE transport state (chunk queue handled on the main actor)
-    private var chunkQueue: [QueuedBLEChunk] = []
-    var readyForNextChunk: Bool = true
-    private let frameConfirmationLock = NSLock()
-    private var awaitingFrameConfirmation = false
-    private var frameConfirmationGeneration: UInt64 = 0
-    private var frameConfirmationDeadline: DispatchWorkItem?
-    private var currentFrameConfirmation: FrameConfirmation?
-    private var expectedFrameCallbackThread: ObjectIdentifier?
+    var chunkQueue = BLEChunkQueue()
+    /// Chunks handed to the transport whose write has not completed, bounded by `chunkWriteCredits()`.
+    var chunkWritesInFlight = 0
+    /// Bumped whenever the queue is reset, so completions of writes issued before it are ignored.
+    var chunkWriteGeneration: UInt64 = 0
+    let frameConfirmationLock = NSLock()
+    var awaitingFrameConfirmation = false
+    var frameConfirmationGeneration: UInt64 = 0
+    var frameConfirmationDeadline: DispatchWorkItem?
+    var currentFrameConfirmation: FrameConfirmation?
+    var expectedFrameCallbackThread: ObjectIdentifier?
+    var queuedSends: [QueuedSend] = []
+
+    // Sample blocks collected while a chunk is decoded and flushed to the delegate once it returns
+    var isBatchingSamples = false
+    var streamClocks: [WaveformSignal: StreamClock] = [:]
+    private let sampleMemory: SampleMemory
+    let statisticsCollector = StatisticsCollector()
+    let latencyRecorder = LatencyRecorder()
+    /// Host receive time of the notification being decoded.
+    var chunkReceivedAt: UInt64 = 0
+    let ecgSamples: SampleBlockBuffer
+    let respirationSamples: SampleBlockBuffer
+    let skinTemperatureSamples: SampleBlockBuffer
+    let pastECGSamples: SampleBlockBuffer
+    let pastRespirationSamples: SampleBlockBuffer
+    let pastSkinTemperatureSamples: SampleBlockBuffer
+    let accelerometerSamples: SampleBlockBuffer
+    let gyroscopeSamples: SampleBlockBuffer
+    let magnetometerSamples: SampleBlockBuffer
+    let quaternionSamples: SampleBlockBuffer
+    let pastAccelerometerSamples: SampleBlockBuffer
+    let pastGyroscopeSamples: SampleBlockBuffer
+    let pastMagnetometerSamples: SampleBlockBuffer
+    let pastQuaternionSamples: SampleBlockBuffer
 
     private func startNotify(
         uuid: CBUUID,
@@ -365,24 +482,22 @@ public class Device: NSObject, @unchecked Sendable {
         commandStateLock.unlock()
 
         var resolvedReason = reason
-        if !checkCompatibility() {
+        if !capabilities.isCompatible {
             deviceDelegate?.didReceiveError(self, error: AidlabError(message: "Unsupported SDK"))
             resolvedReason = .sdkOutdated
         }
 
         stopAllNotifications()
         resetBleQueue()
-
-        if let aidlabSDK {
-            AidlabSDK_set_error_callback(nil, nil, aidlabSDK)
-            AidlabSDK_set_context(nil, aidlabSDK)
-            AidlabSDK_destroy(aidlabSDK)
-        }
-        aidlabSDK = nil
+        destroyAidlabSDK()
 
         deviceDelegate?.didDisconnect(self, reason: resolvedReason)
         deviceDelegate = nil
         transport.onDisconnect = nil
+
+        if preparesReconnect, resolvedReason != .sdkOutdated, spareAidlabSDK == nil, let firmwareRevision {
+            spareAidlabSDK = makeAidlabSDK(firmwareRevision: firmwareRevision).map { ($0, firmwareRevision) }
+        }
     }
 
     private func readConnectionMetadata(completion: @escaping () -> Void) {
@@ -428,7 +543,7 @@ public class Device: NSObject, @unchecked Sendable {
 
     /// Serial number, firmware, and hardware version are ready
     private func didConnect() {
-        if !checkCompatibility() {
+        if !capabilities.isCompatible {
             deviceDelegate?.didConnect(self)
             disconnect()
             return
@@ -438,12 +553,8 @@ public class Device: NSObject, @unchecked Sendable {
 
         createAidlabSDK()
 
-        if usesV4Protocol() {
-            let negotiated = transport.mtuSize
-            maxCmdPackageLength = min(512, max(20, negotiated > 0 ? negotiated : 20))
-        } else {
-            maxCmdPackageLength = 20
-        }
+        let negotiated = transport.mtuSize
+        maxCmdPackageLength = min(capabilities.maxCommandChunkLength, max(20, negotiated))
         startNotify(
             uuid: cmdCharacteristicUUID,
             required: true,
@@ -471,213 +582,109 @@ public class Device: NSObject, @unchecked Sendable {
             return
         }
 
-        var fwVersion: [UInt8] = Array(firmwareRevision.utf8)
-        aidlabSDK = AidlabSDK_create(&fwVersion, Int32(fwVersion.count))
+        let aidlabSDK = takeSpareAidlabSDK(for: firmwareRevision) ?? makeAidlabSDK(firmwareRevision: firmwareRevision)
+        capture?.firmwareRevision = firmwareRevision
         resetBleQueue()
 
         guard let aidlabSDK else {
             deviceDelegate?.didReceiveError(self, error: AidlabError(message: "Internal error"))
             return
         }
-
-        let context = Unmanaged.passUnretained(self).toOpaque()
-        AidlabSDK_set_context(context, aidlabSDK)
-        AidlabSDK_set_error_callback(didReceiveError, context, aidlabSDK)
-
-        AidlabSDK_set_ble_send_callback(bleSendCallback, aidlabSDK)
-        AidlabSDK_set_ble_ready_callback(bleReadyCallback, aidlabSDK)
-
-        AidlabSDK_init_callbacks(didReceiveECG,
-                                 didReceiveRespiration,
-                                 didReceiveSkinTemperature,
-                                 didReceiveAccelerometer,
-                                 didReceiveGyroscope,
-                                 didReceiveMagnetometer,
-                                 didReceiveBatteryLevel,
-                                 didDetectActivity,
-                                 didReceiveSteps,
-                                 didReceiveOrientation,
-                                 didReceiveQuaternion,
-                                 didReceiveRespirationRate,
-                                 wearStateDidChange,
-                                 didReceiveHeartRate,
-                                 didReceiveRr,
-                                 didReceiveSoundVolume,
-                                 didDetect,
-                                 didDetectUserEvent,
-                                 didReceivePressure,
-                                 pressureWearStateDidChange,
-                                 didReceiveBodyPosition,
-                                 didReceiveSignalQuality,
-                                 aidlabSDK)
-
-        AidlabSDK_set_eda_callback(didReceiveEDA, aidlabSDK)
-        AidlabSDK_set_gps_callback(didReceiveGPS, aidlabSDK)
-
-        AidlabSDK_set_payload_callback(didReceivePayload, aidlabSDK)
-        AidlabSDK_set_process_error_callback(didReceiveProcessError, aidlabSDK)
-
-        AidlabSDK_init_synchronization_callbacks(syncStateDidChange, didReceiveUnsynchronizedSize, didReceivePastECG, didReceivePastRespiration, didReceivePastSkinTemperature, didReceivePastHeartRate, didReceivePastRr, didReceivePastActivity, didReceivePastRespirationRate, didReceivePastSteps, didDetectPastUserEvent, didReceivePastSoundVolume, didReceivePastPressure, didReceivePastAccelerometer, didReceivePastGyroscope, didReceivePastQuaternion, didReceivePastOrientation, didReceivePastMagnetometer, didReceivePastBodyPosition, didReceivePastSignalQuality, aidlabSDK)
-        AidlabSDK_set_past_eda_callback(didReceivePastEDA, aidlabSDK)
-        AidlabSDK_set_past_gps_callback(didReceivePastGPS, aidlabSDK)
-    }
-
-    func checkCompatibility() -> Bool {
-        guard let version = firmwareRevision else { return true }
-        let stringArray = version.split(separator: ".")
-        let minor = Int(stringArray[1]) ?? 0
-        return Config.supportedAidlabVersion >= minor ? true : false
+        // The previous session may still be decoding its last chunks on a worker; this one starts after it.
+        let session = DecodeSession(
+            aidlabSDK: aidlabSDK,
+            delegate: deviceDelegate,
+            settings: sessionSettings,
+            worker: decodeEngine?.assignWorker(),
+            after: endingSession
+        )
+        session.enqueue { [self] in
+            discardSampleBlocks()
+            decodingSession = session
+        }
+        self.session = session
+    }
+
+    private var sessionSettings: DecodeSession.Settings {
+        DecodeSession.Settings(
+            enabledDataTypes: enabledDataTypes,
+            synchronizationPageSize: synchronizationPageSize,
+            capture: capture,
+            recorder: recorder,
+            sampleRings: sampleRings,
+            reportsStreamDescriptors: reportsStreamDescriptors,
+            measuresLatency: measuresLatency,
+            tracer: tracer
+        )
     }
 
-    // -- Private --------------------------------------------------------------
-
-    private func sendRawBleData(_ data: [UInt8], completesFrame: Bool) {
-        guard !data.isEmpty else { return }
-
-        let chunkSize = resolvedChunkSize()
-        var offset = 0
-
-        while offset < data.count {
-            let endIndex = min(offset + chunkSize, data.count)
-            let chunk = Data(data[offset ..< endIndex])
-            chunkQueue.append(
-                QueuedBLEChunk(
-                    data: chunk,
-                    completesFrame: completesFrame && endIndex == data.count
-                )
-            )
-            offset = endIndex
-        }
-
-        drainChunkQueue()
+    private func updateSession(_ body: @escaping @Sendable (inout DecodeSession.Settings) -> Void) {
+        session?.update(body)
     }
 
-    private func resolvedChunkSize() -> Int {
-        guard usesV4Protocol() else {
-            return 20
-        }
-
-        let negotiated = transport.mtuSize
-        if negotiated > 0 {
-            return min(512, min(maxCmdPackageLength, max(20, negotiated)))
+    /// Creates an SDK instance for `firmwareRevision` with every callback registered.
+    private func makeAidlabSDK(firmwareRevision: String) -> UnsafeMutableRawPointer? {
+        var fwVersion: [UInt8] = Array(firmwareRevision.utf8)
+        guard let aidlabSDK = AidlabSDK_create(&fwVersion, Int32(fwVersion.count)) else {
+            return nil
         }
-        return 20
-    }
-
-    func resetBleQueue() {
-        chunkQueue.removeAll(keepingCapacity: false)
-        readyForNextChunk = true
-        completeFrameConfirmation(error: AidlabError(message: "BLE frame was reset"))
+        registerCallbacks(on: aidlabSDK)
+        return aidlabSDK
     }
 
-    private func beginFrameConfirmation() -> FrameConfirmation? {
-        frameConfirmationLock.lock()
-        guard !awaitingFrameConfirmation else {
-            frameConfirmationLock.unlock()
+    private func takeSpareAidlabSDK(for firmwareRevision: String) -> UnsafeMutableRawPointer? {
+        guard let spare = spareAidlabSDK else { return nil }
+        spareAidlabSDK = nil
+        guard spare.firmwareRevision == firmwareRevision else {
+            // Firmware was updated while disconnected.
+            Device.destroyInstance(spare.pointer)
             return nil
         }
-        let confirmation = FrameConfirmation()
-        awaitingFrameConfirmation = true
-        currentFrameConfirmation = confirmation
-        frameConfirmationGeneration &+= 1
-        let previousDeadline = frameConfirmationDeadline
-        frameConfirmationDeadline = nil
-        frameConfirmationLock.unlock()
-        previousDeadline?.cancel()
-        return confirmation
+        return spare.pointer
     }
 
-    private func emitTrackedFrame(_ action: () -> Void) -> Bool {
-        let thread = ObjectIdentifier(Thread.current)
-        frameConfirmationLock.lock()
-        expectedFrameCallbackThread = thread
-        frameConfirmationLock.unlock()
-
-        action()
-
-        frameConfirmationLock.lock()
-        let emitted = expectedFrameCallbackThread != thread
-        if !emitted {
-            expectedFrameCallbackThread = nil
+    func destroyAidlabSDK() {
+        guard let session else { return }
+        // With an engine the instance is torn down on the session's queue, after chunks already queued there.
+        session.end { [self] aidlabSDK in
+            endDecodeSession(aidlabSDK)
         }
-        frameConfirmationLock.unlock()
-        return emitted
+        endingSession = session
+        self.session = nil
     }
 
-    private func consumeTrackedFrameCallback() -> Bool {
-        let thread = ObjectIdentifier(Thread.current)
-        frameConfirmationLock.lock()
-        let tracked = expectedFrameCallbackThread == thread
-        if tracked {
-            expectedFrameCallbackThread = nil
-        }
-        frameConfirmationLock.unlock()
-        return tracked
+    /// Runs where the session ran. A synchronization page that was still filling is delivered before the
+    /// instance goes away.
+    private func endDecodeSession(_ aidlabSDK: UnsafeMutableRawPointer) {
+        flushPastSampleBlocks(minimumCount: 1)
+        Device.destroyInstance(aidlabSDK)
+        streamClocks.removeAll()
+        decodingSession = nil
     }
 
-    private func armFrameConfirmationDeadline() {
-        if !usesV4Protocol() {
-            completeFrameConfirmation()
-            return
-        }
-
-        frameConfirmationLock.lock()
-        guard awaitingFrameConfirmation else {
-            frameConfirmationLock.unlock()
-            return
-        }
-
-        frameConfirmationGeneration &+= 1
-        let generation = frameConfirmationGeneration
-        let previousDeadline = frameConfirmationDeadline
-        let deadline = DispatchWorkItem { [weak self] in
-            self?.frameConfirmationDidTimeout(generation: generation)
-        }
-        frameConfirmationDeadline = deadline
-        frameConfirmationLock.unlock()
-
-        previousDeadline?.cancel()
-        DispatchQueue.main.asyncAfter(
-            deadline: .now() + Device.frameConfirmationTimeout,
-            execute: deadline
-        )
+    private static func destroyInstance(_ aidlabSDK: UnsafeMutableRawPointer) {
+        AidlabSDK_set_error_callback(nil, nil, aidlabSDK)
+        AidlabSDK_set_context(nil, aidlabSDK)
+        AidlabSDK_destroy(aidlabSDK)
     }
 
-    private func completeFrameConfirmation(error: Error? = nil) {
-        frameConfirmationLock.lock()
-        awaitingFrameConfirmation = false
-        frameConfirmationGeneration &+= 1
-        let deadline = frameConfirmationDeadline
-        let confirmation = currentFrameConfirmation
-        frameConfirmationDeadline = nil
-        currentFrameConfirmation = nil
-        expectedFrameCallbackThread = nil
-        frameConfirmationLock.unlock()
-        deadline?.cancel()
-        if let error {
-            confirmation?.finish(.failure(error))
-        } else {
-            confirmation?.finish(.success(()))
+    /// Feeds one captured record through the same path as a live notification.
+    func ingest(_ record: ChunkCapture.Record) {
+        switch record.kind {
+        case .commandChunk:
+            processCommandChunk(record.bytes)
+        case .battery:
+            processBatteryPacket(record.bytes)
+        case .outboundFrame:
+            break
+        default:
+            if let characteristic = LegacyCharacteristic.characteristic(for: record.kind) {
+                processLegacyData(record.bytes, from: characteristic)
+            }
         }
     }
 
-    private func failFrameTransmission(_ error: AidlabError) {
-        chunkQueue.removeAll(keepingCapacity: false)
-        readyForNextChunk = true
-        completeFrameConfirmation(error: error)
-        deviceDelegate?.didReceiveError(self, error: error)
-        transport.disconnect()
-    }
-
-    private func frameConfirmationDidTimeout(generation: UInt64) {
-        frameConfirmationLock.lock()
-        guard awaitingFrameConfirmation, frameConfirmationGeneration == generation else {
-            frameConfirmationLock.unlock()
-            return
-        }
-        frameConfirmationLock.unlock()
-        failFrameTransmission(AidlabError(message: "BLE frame confirmation timed out"))
-    }
+    // -- Private --------------------------------------------------------------
 
     private struct SystemProcessResult {
         let status: UInt8
@@ -744,11 +751,14 @@ public class Device: NSObject, @unchecked Sendable {
         spawnedProcessId: UInt8?,
         destinationPid: UInt16
     ) async throws -> UInt16? {
-        guard let aidlabSDK else {
+        guard session != nil else {
             throw AidlabError(message: "Device is not connected")
         }
-        guard let frameConfirmation = beginFrameConfirmation() else {
-            throw AidlabError(message: "Previous BLE frame is not confirmed")
+        let frameConfirmation = try await acquireFrameConfirmation()
+        guard session != nil else {
+            let error = AidlabError(message: "Device is not connected")
+            completeFrameConfirmation(error: error)
+            throw error
         }
 
         let expectsShellResponse = destinationPid == 0
@@ -765,7 +775,7 @@ public class Device: NSObject, @unchecked Sendable {
                 if pendingProcessCommand != nil {
                     commandStateLock.unlock()
                     let error = AidlabError(message: "Another process command is already pending")
-                    completeFrameConfirmation(error: error)
+                    completeFrameConfirmation(error: error, keepsQueuedSends: true)
                     continuation.resume(throwing: error)
                     return
                 }
@@ -773,8 +783,8 @@ public class Device: NSObject, @unchecked Sendable {
                 commandStateLock.unlock()
             }
 
-            var bytes = payload
-            guard emitTrackedFrame({
+            emitTrackedFrame({ aidlabSDK in
+                var bytes = payload
                 if expectsShellResponse {
                     AidlabSDK_send(&bytes, Int32(bytes.count), 0, aidlabSDK)
                 } else {
@@ -785,28 +795,29 @@ public class Device: NSObject, @unchecked Sendable {
                         aidlabSDK
                     )
                 }
-            }) else {
-                let error = AidlabError(message: "SDK rejected the BLE frame")
-                if waitsForLifecycle {
-                    completePendingProcessCommand(.failure(error), waiter: waiter)
-                } else {
-                    continuation.resume(throwing: error)
+            }, completion: { [self] error in
+                if let error {
+                    if waitsForLifecycle {
+                        completePendingProcessCommand(.failure(error), waiter: waiter)
+                    } else {
+                        continuation.resume(throwing: error)
+                    }
+                    failFrameTransmission(error)
+                    return
                 }
-                failFrameTransmission(error)
-                return
-            }
 
-            if waitsForLifecycle {
-                DispatchQueue.global().asyncAfter(deadline: .now() + timeoutSeconds) { [weak self, weak waiter] in
-                    guard let self, let waiter else { return }
-                    completePendingProcessCommand(
-                        .failure(AidlabError(message: "Timed out waiting for process command result")),
-                        waiter: waiter
-                    )
+                if waitsForLifecycle {
+                    DispatchQueue.global().asyncAfter(deadline: .now() + timeoutSeconds) { [weak self, weak waiter] in
+                        guard let self, let waiter else { return }
+                        completePendingProcessCommand(
+                            .failure(AidlabError(message: "Timed out waiting for process command result")),
+                            waiter: waiter
+                        )
+                    }
+                } else {
+                    continuation.resume(returning: nil)
                 }
-            } else {
-                continuation.resume(returning: nil)
-            }
+            })
         }
 
         try await frameConfirmation.wait()
@@ -824,11 +835,14 @@ public class Device: NSObject, @unchecked Sendable {
     ) async throws -> UInt16? {
         await processCommandGate.lock()
         do {
-            guard let aidlabSDK else {
+            guard session != nil else {
                 throw AidlabError(message: "Device is not connected")
             }
-            guard let frameConfirmation = beginFrameConfirmation() else {
-                throw AidlabError(message: "Previous BLE frame is not confirmed")
+            let frameConfirmation = try await acquireFrameConfirmation()
+            guard session != nil else {
+                let error = AidlabError(message: "Device is not connected")
+                completeFrameConfirmation(error: error)
+                throw error
             }
             let result: SystemProcessResult = try await withCheckedThrowingContinuation { continuation in
                 let waiter = PendingProcessTermination(pid: pid, continuation: continuation)
@@ -837,30 +851,31 @@ public class Device: NSObject, @unchecked Sendable {
                 if pendingProcessTermination != nil {
                     commandStateLock.unlock()
                     let error = AidlabError(message: "Another process termination is pending")
-                    completeFrameConfirmation(error: error)
+                    completeFrameConfirmation(error: error, keepsQueuedSends: true)
                     continuation.resume(throwing: error)
                     return
                 }
                 pendingProcessTermination = waiter
                 commandStateLock.unlock()
 
-                var bytes = payload
-                guard emitTrackedFrame({
+                emitTrackedFrame({ aidlabSDK in
+                    var bytes = payload
                     AidlabSDK_send_process_command(&bytes, Int32(bytes.count), Int32(pid), aidlabSDK)
-                }) else {
-                    let error = AidlabError(message: "SDK rejected the BLE frame")
-                    completePendingProcessTermination(.failure(error), waiter: waiter)
-                    failFrameTransmission(error)
-                    return
-                }
+                }, completion: { [self] error in
+                    if let error {
+                        completePendingProcessTermination(.failure(error), waiter: waiter)
+                        failFrameTransmission(error)
+                        return
+                    }
 
-                DispatchQueue.global().asyncAfter(deadline: .now() + timeoutSeconds) { [weak self, weak waiter] in
-                    guard let self, let waiter else { return }
-                    completePendingProcessTermination(
-                        .failure(AidlabError(message: "Timed out waiting for process termination")),
-                        waiter: waiter
-                    )
-                }
+                    DispatchQueue.global().asyncAfter(deadline: .now() + timeoutSeconds) { [weak self, weak waiter] in
+                        guard let self, let waiter else { return }
+                        completePendingProcessTermination(
+                            .failure(AidlabError(message: "Timed out waiting for process termination")),
+                            waiter: waiter
+                        )
+                    }
+                })
             }
             try await frameConfirmation.wait()
             await processCommandGate.unlock()
@@ -917,7 +932,7 @@ public class Device: NSObject, @unchecked Sendable {
         }
     }
 
-    private func handleProcessCommandPayload(process: String, payload: Data) {
+    func handleProcessCommandPayload(process: String, payload: Data) {
         guard let result = parseSystemProcessInformation(process: process, payload: payload) else {
             return
         }
@@ -957,7 +972,7 @@ public class Device: NSObject, @unchecked Sendable {
             completePendingProcessTermination(.success(result), waiter: terminationWaiter)
         }
         if result.status == Device.systemKillSuccess {
-            deviceDelegate?.processDidTerminate(self, pid: result.pid)
+            decodingSession?.delegate?.processDidTerminate(self, pid: result.pid)
         }
     }
 
@@ -1005,12 +1020,13 @@ public class Device: NSObject, @unchecked Sendable {
         }
 
         for uuid in uuids {
+            guard let characteristic = LegacyCharacteristic.characteristic(for: uuid) else { continue }
             legacyCollectionNotificationUUIDs.insert(uuid)
             startNotify(
                 uuid: uuid,
                 required: false,
                 onData: { [weak self] data in
-                    self?.processLegacyData(uuid: uuid, data: data)
+                    self?.processLegacyData(data, from: characteristic)
                 }
             )
         }
@@ -1025,434 +1041,70 @@ public class Device: NSObject, @unchecked Sendable {
     }
 
     private func processCommandChunk(_ data: Data) {
-        guard let aidlabSDK else { return }
-        var scratchVal = [UInt8](data)
-        AidlabSDK_process_ble_chunk(&scratchVal, Int32(scratchVal.count), aidlabSDK)
-    }
-
-    private func processBatteryPacket(_ data: Data) {
-        guard aidlabSDK != nil else { return }
-        var scratchVal = [UInt8](data)
-        AidlabSDK_process_battery_package(&scratchVal, Int32(scratchVal.count), aidlabSDK)
-    }
-
-    private func processLegacyData(
-        uuid: CBUUID,
-        data: Data
-    ) {
-        guard aidlabSDK != nil else { return }
-        var scratchVal = [UInt8](data)
-        let count = Int32(scratchVal.count)
-
-        switch uuid {
-        case temperatureCharacteristicUUID:
-            processTemperaturePackage(&scratchVal, count, aidlabSDK)
-        case ecgCharacteristicUUID:
-            processECGPackage(&scratchVal, count, aidlabSDK)
-        case respirationCharacteristicUUID:
-            processRespirationPackage(&scratchVal, count, aidlabSDK)
-        case motionCharacteristicUUID:
-            processMotionPackage(&scratchVal, count, aidlabSDK)
-        case soundVolumeCharacteristicUUID:
-            processSoundVolumePackage(&scratchVal, count, aidlabSDK)
-        case MotionService.stepsUUID:
-            processStepsPackage(&scratchVal, count, aidlabSDK)
-        case MotionService.activityUUID:
-            processActivityPackage(&scratchVal, count, aidlabSDK)
-        case MotionService.orientationUUID:
-            processOrientationPackage(&scratchVal, count, aidlabSDK)
-        case HeartRateService.heartRateMeasurementCharacteristic:
-            processHeartRatePackage(&scratchVal, count, aidlabSDK)
-        case BatteryLevelService.batteryLevelCharacteristic, batteryCharacteristicUUID:
-            AidlabSDK_process_battery_package(&scratchVal, count, aidlabSDK)
-        default:
-            break
+        guard let session else { return }
+        let receivedAt = DispatchTime.now().uptimeNanoseconds
+        capture?.append(.commandChunk, data)
+        session.useInstance { [self] aidlabSDK in
+            guard let aidlabSDK else { return }
+            decodeCommandChunk(data, receivedAt: receivedAt, aidlabSDK: aidlabSDK)
         }
     }
 
-    func drainChunkQueue() {
-        guard readyForNextChunk else { return }
-        guard !chunkQueue.isEmpty else { return }
-
-        let chunk = chunkQueue.removeFirst()
-        readyForNextChunk = false
-        transport.writeCharacteristic(
-            cmdCharacteristicUUID,
-            data: chunk.data,
-            withResponse: !usesV4Protocol()
-        ) { [weak self] result in
-            guard let self else { return }
-            switch result {
-            case .success:
-                handleCommandWriteResult(error: nil, completesFrame: chunk.completesFrame)
-            case let .failure(error):
-                handleCommandWriteResult(error: error, completesFrame: chunk.completesFrame)
+    private func decodeCommandChunk(_ data: Data, receivedAt: UInt64, aidlabSDK: UnsafeMutableRawPointer) {
+        withSampleBatching(byteCount: data.count, receivedAt: receivedAt) {
+            withChunkBytes(data) { bytes, count in
+                AidlabSDK_process_ble_chunk(bytes, count, aidlabSDK)
             }
         }
     }
 
-    func handleCommandWriteResult(error: Error?, completesFrame: Bool) {
-        if let error {
-            failFrameTransmission(AidlabError.wrapping(error))
-            return
-        }
-
-        if completesFrame {
-            armFrameConfirmationDeadline()
+    private func processBatteryPacket(_ data: Data) {
+        guard let session else { return }
+        let receivedAt = DispatchTime.now().uptimeNanoseconds
+        capture?.append(.battery, data)
+        session.useInstance { [self] aidlabSDK in
+            guard let aidlabSDK else { return }
+            decodeBatteryPacket(data, receivedAt: receivedAt, aidlabSDK: aidlabSDK)
         }
-        readyForNextChunk = true
-        drainChunkQueue()
-    }
-
-    // -- AidlabSDK callback handlers ------------------------------------------
-
-    // BLE Communication callbacks
-    private let bleSendCallback: callbackBLESend = { context, data, size in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-
-        let dataArray = Array(UnsafeBufferPointer(start: data, count: Int(size)))
-        let completesFrame = self_.consumeTrackedFrameCallback()
-        self_.sendRawBleData(dataArray, completesFrame: completesFrame)
-    }
-
-    private let bleReadyCallback: callbackBLEReady = { context in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.completeFrameConfirmation()
-    }
-
-    private let didReceiveECG: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveECG(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceiveRespiration: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveRespiration(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceiveSkinTemperature: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveSkinTemperature(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceiveAccelerometer: callbackAccelerometer = { context, timestamp, ax, ay, az in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveAccelerometer(self_, timestamp: timestamp, ax: ax, ay: ay, az: az)
-    }
-
-    private let didReceiveGyroscope: callbackGyroscope = { context, timestamp, gx, gy, gz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveGyroscope(self_, timestamp: timestamp, gx: gx, gy: gy, gz: gz)
-    }
-
-    private let didReceiveMagnetometer: callbackMagnetometer = { context, timestamp, mx, my, mz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveMagnetometer(self_, timestamp: timestamp, mx: mx, my: my, mz: mz)
-    }
-
-    private let didReceiveQuaternion: callbackQuaternion = { context, timestamp, qw, qx, qy, qz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveQuaternion(self_, timestamp: timestamp, qw: qw, qx: qx, qy: qy, qz: qz)
-    }
-
-    private let didReceiveOrientation: callbackOrientation = { context, timestamp, roll, pitch, yaw in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveOrientation(self_, timestamp: timestamp, roll: roll, pitch: pitch, yaw: yaw)
-    }
-
-    private let didReceiveEDA: callbackEda = { context, timestamp, conductance in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveEDA(self_, timestamp: timestamp, conductance: conductance)
-    }
-
-    private let didReceiveGPS: callbackGps = { context, timestamp, latitude, longitude, altitude, speed, heading, hdop in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveGPS(self_,
-                                            timestamp: timestamp,
-                                            latitude: Double(latitude),
-                                            longitude: Double(longitude),
-                                            altitude: Double(altitude),
-                                            speed: speed,
-                                            heading: heading,
-                                            hdop: hdop)
-    }
-
-    private let didReceiveBodyPosition: callbackBodyPosition = { context, timestamp, bodyPosition in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveBodyPosition(self_, timestamp: timestamp, bodyPosition: BodyPosition(bodyPosition: bodyPosition))
-    }
-
-    private let didReceiveHeartRate: callbackHeartRate = { context, timestamp, heartRate in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveHeartRate(self_, timestamp: timestamp, heartRate: heartRate)
-    }
-
-    private let didReceiveRr: callbackRr = { context, timestamp, rr in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveRr(self_, timestamp: timestamp, rr: rr)
-    }
-
-    private let didReceiveRespirationRate: callbackRespirationRate = { context, timestamp, respirationRate in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveRespirationRate(self_, timestamp: timestamp, value: respirationRate)
-    }
-
-    private let wearStateDidChange: callbackWearState = { context, state in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.wearStateDidChange(self_, wearState: WearState(wearState: state))
-    }
-
-    private let didReceiveSoundVolume: callbackSoundVolume = { context, timestamp, soundVolume in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveSoundVolume(self_, timestamp: timestamp, soundVolume: soundVolume)
-    }
-
-    private let didReceivePressure: callbackPressure = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePressure(self_, timestamp: timestamp, value: value)
-    }
-
-    private let pressureWearStateDidChange: callbackWearState = { context, state in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.pressureWearStateDidChange(self_, wearState: WearState(wearState: state))
-    }
-
-    private let didDetect: callback_function = { context, exercise in
-        guard let context else { return }
-        if exercise == AidlabSDK.exerciseNone { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didDetectExercise(self_, exercise: Exercise(exercise: exercise))
     }
 
-    private let didDetectActivity: callbackActivity = { context, timestamp, activity in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveActivity(self_, timestamp: timestamp, activity: ActivityType(activityType: activity))
-    }
-
-    private let didReceivePayload: callbackPayload = { context, process, payload, payloadLength, options in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-
-        let processString = process.map { String(cString: $0) } ?? "unknown"
-
-        let rawPayload = if let payload, payloadLength > 0 {
-            Data(bytes: payload, count: Int(payloadLength))
-        } else {
-            Data()
+    private func decodeBatteryPacket(_ data: Data, receivedAt: UInt64, aidlabSDK: UnsafeMutableRawPointer) {
+        withSampleBatching(byteCount: data.count, receivedAt: receivedAt) {
+            withChunkBytes(data) { bytes, count in
+                AidlabSDK_process_battery_package(bytes, count, aidlabSDK)
+            }
         }
-
-        self_.handleProcessCommandPayload(process: processString, payload: rawPayload)
-        self_.deviceDelegate?.didReceivePayload(self_, process: processString, payload: rawPayload, options: options)
     }
 
-    private let didReceiveProcessError: callbackProcessError = { context, process, pid, payload, payloadLength, options in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        let processString = process.map { String(cString: $0) } ?? "unknown"
-        let rawPayload = if let payload, payloadLength > 0 {
-            Data(bytes: payload, count: Int(payloadLength))
-        } else {
-            Data()
+    private func processLegacyData(_ data: Data, from characteristic: LegacyCharacteristic) {
+        guard let session else { return }
+        let receivedAt = DispatchTime.now().uptimeNanoseconds
+        capture?.append(characteristic.kind, data)
+        session.useInstance { [self] aidlabSDK in
+            guard let aidlabSDK else { return }
+            decodeLegacyData(data, decoder: characteristic.decoder, receivedAt: receivedAt, aidlabSDK: aidlabSDK)
         }
-        self_.deviceDelegate?.didReceiveProcessError(
-            self_, process: processString, pid: pid, payload: rawPayload, options: options
-        )
-    }
-
-    private let didDetectUserEvent: callbackUserEvent = { context, timestamp in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didDetectUserEvent(self_, timestamp: timestamp)
-    }
-
-    private let didReceiveError: callbackError = { context, code, text in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-
-        guard let cStringPointer = text,
-              let string = String(validatingCString: cStringPointer)
-        else { return }
-
-        let error = AidlabError.fromCore(rawCode: Int32(code.rawValue), message: string)
-        self_.completeFrameConfirmation(error: error)
-        self_.deviceDelegate?.didReceiveError(self_, error: error)
-    }
-
-    private let didReceiveSignalQuality: callbackSignalQuality = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveSignalQuality(self_, timestamp: timestamp, value: Int32(value))
-    }
-
-    private let didReceiveBatteryLevel: callbackBatteryLevel = { context, stateOfCharge in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveBatteryLevel(self_, stateOfCharge: stateOfCharge)
-    }
-
-    private let didReceiveSteps: callbackSteps = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveSteps(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastECG: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastECG(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastRespiration: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastRespiration(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastSkinTemperature: callbackSampleTime = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastSkinTemperature(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastHeartRate: callbackHeartRate = { context, timestamp, heartRate in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastHeartRate(self_, timestamp: timestamp, heartRate: heartRate)
-    }
-
-    private let syncStateDidChange: callbackSyncState = { context, state in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.syncStateDidChange(self_, state: SyncState(syncState: state))
-    }
-
-    private let didReceiveUnsynchronizedSize: callbackUnsynchronizedSize = { context, unsynchronizedSize, syncBytesPerSecond in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceiveUnsynchronizedSize(self_, unsynchronizedSize: unsynchronizedSize, syncBytesPerSecond: syncBytesPerSecond)
-    }
-
-    private let didReceivePastRespirationRate: callbackRespirationRate = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastRespirationRate(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastActivity: callbackActivity = { context, timestamp, activity in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastActivity(self_, timestamp: timestamp, activity: ActivityType(activityType: activity))
-    }
-
-    private let didReceivePastSteps: callbackSteps = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastSteps(self_, timestamp: timestamp, value: value)
     }
 
-    private let didReceivePastRr: callbackRr = { context, timestamp, rr in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastRr(self_, timestamp: timestamp, rr: rr)
-    }
-
-    private let didReceivePastSoundVolume: callbackSoundVolume = { context, timestamp, soundVolume in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastSoundVolume(self_, timestamp: timestamp, soundVolume: soundVolume)
-    }
-
-    private let didReceivePastPressure: callbackPressure = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastPressure(self_, timestamp: timestamp, value: value)
-    }
-
-    private let didReceivePastAccelerometer: callbackAccelerometer = { context, timestamp, ax, ay, az in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastAccelerometer(self_, timestamp: timestamp, ax: ax, ay: ay, az: az)
-    }
-
-    private let didReceivePastGyroscope: callbackGyroscope = { context, timestamp, gx, gy, gz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastGyroscope(self_, timestamp: timestamp, gx: gx, gy: gy, gz: gz)
-    }
-
-    private let didReceivePastQuaternion: callbackQuaternion = { context, timestamp, qw, qx, qy, qz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastQuaternion(self_, timestamp: timestamp, qw: qw, qx: qx, qy: qy, qz: qz)
-    }
-
-    private let didReceivePastOrientation: callbackOrientation = { context, timestamp, roll, pitch, yaw in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastOrientation(self_, timestamp: timestamp, roll: roll, pitch: pitch, yaw: yaw)
-    }
-
-    private let didReceivePastEDA: callbackEda = { context, timestamp, conductance in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastEDA(self_, timestamp: timestamp, conductance: conductance)
-    }
-
-    private let didReceivePastGPS: callbackGps = { context, timestamp, latitude, longitude, altitude, speed, heading, hdop in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastGPS(self_,
-                                                timestamp: timestamp,
-                                                latitude: Double(latitude),
-                                                longitude: Double(longitude),
-                                                altitude: Double(altitude),
-                                                speed: speed,
-                                                heading: heading,
-                                                hdop: hdop)
-    }
-
-    private let didReceivePastMagnetometer: callbackMagnetometer = { context, timestamp, mx, my, mz in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastMagnetometer(self_, timestamp: timestamp, mx: mx, my: my, mz: mz)
-    }
-
-    private let didReceivePastBodyPosition: callbackBodyPosition = { context, timestamp, bodyPosition in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastBodyPosition(self_, timestamp: timestamp, bodyPosition: BodyPosition(bodyPosition: bodyPosition))
-    }
-
-    private let didDetectPastUserEvent: callbackUserEvent = { context, timestamp in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didDetectPastUserEvent(self_, timestamp: timestamp)
+    private func decodeLegacyData(
+        _ data: Data,
+        decoder: LegacyCharacteristic.Decoder,
+        receivedAt: UInt64,
+        aidlabSDK: UnsafeMutableRawPointer
+    ) {
+        withSampleBatching(byteCount: data.count, receivedAt: receivedAt) {
+            withChunkBytes(data) { bytes, count in
+                decoder(bytes, count, aidlabSDK)
+            }
+        }
     }
 
-    private let didReceivePastSignalQuality: callbackSignalQuality = { context, timestamp, value in
-        guard let context else { return }
-        let self_ = Unmanaged<Device>.fromOpaque(context).takeUnretainedValue()
-        self_.deviceDelegate?.didReceivePastSignalQuality(self_, timestamp: timestamp, value: UInt8(value))
+    /// Hands the notification bytes to the SDK in place instead of copying them into an array first.
+    /// The SDK takes `const` input and consumes it before returning, so the pointer never outlives `body`.
+    private func withChunkBytes(_ data: Data, _ body: (UnsafePointer<UInt8>, Int32) -> Void) {
+        data.withUnsafeBytes { rawBuffer in
+            guard let bytes = rawBuffer.bindMemory(to: UInt8.self).baseAddress else { return }
+            body(bytes, Int32(rawBuffer.count))
+        }
     }
 }
@@ -131,9 +131,181 @@ public protocol DeviceDelegate: AnyObject {
     func pressureWearStateDidChange(_ device: Device, wearState: WearState)
 
     func didReceivePressure(_ device: Device, timestamp: UInt64, value: Int32)
+
+    /// Called once per decoded chunk with every ECG sample it contained.
+    /// The default implementation forwards each sample to `didReceiveECG(_:timestamp:value:)`.
+    func didReceiveECG(_ device: Device, samples: SampleBlock)
+
+    func didReceiveRespiration(_ device: Device, samples: SampleBlock)
+
+    func didReceiveSkinTemperature(_ device: Device, samples: SampleBlock)
+
+    func didReceivePastECG(_ device: Device, samples: SampleBlock)
+
+    func didReceivePastRespiration(_ device: Device, samples: SampleBlock)
+
+    func didReceivePastSkinTemperature(_ device: Device, samples: SampleBlock)
+
+    /// Called once per decoded chunk with every accelerometer sample it contained, as aligned x/y/z columns.
+    /// The default implementation forwards each sample to `didReceiveAccelerometer(_:timestamp:ax:ay:az:)`.
+    func didReceiveAccelerometer(_ device: Device, samples: VectorBlock)
+
+    func didReceiveGyroscope(_ device: Device, samples: VectorBlock)
+
+    func didReceiveMagnetometer(_ device: Device, samples: VectorBlock)
+
+    func didReceiveQuaternion(_ device: Device, samples: QuaternionBlock)
+
+    func didReceivePastAccelerometer(_ device: Device, samples: VectorBlock)
+
+    func didReceivePastGyroscope(_ device: Device, samples: VectorBlock)
+
+    func didReceivePastMagnetometer(_ device: Device, samples: VectorBlock)
+
+    func didReceivePastQuaternion(_ device: Device, samples: QuaternionBlock)
+
+    /// Called with `Device.reportsStreamDescriptors` enabled, right before the block that contains
+    /// `descriptor.sampleIndex` is delivered. A stream's `.start` descriptor is anchored at its second sample,
+    /// the first one from which the period is known.
+    func streamDescriptorDidChange(_ device: Device, descriptor: StreamDescriptor)
 }
 
 public extension DeviceDelegate {
     func processDidTerminate(_: Device, pid _: UInt16) {}
     func didReceiveProcessError(_: Device, process _: String, pid _: UInt16, payload _: Data, options _: UInt64) {}
+    func streamDescriptorDidChange(_: Device, descriptor _: StreamDescriptor) {}
+
+    func didReceiveECG(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceiveECG(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceiveRespiration(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceiveRespiration(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceiveSkinTemperature(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceiveSkinTemperature(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceivePastECG(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceivePastECG(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceivePastRespiration(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceivePastRespiration(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceivePastSkinTemperature(_ device: Device, samples: SampleBlock) {
+        for (timestamp, value) in zip(samples.timestamps, samples.values) {
+            didReceivePastSkinTemperature(device, timestamp: timestamp, value: value)
+        }
+    }
+
+    func didReceiveAccelerometer(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceiveAccelerometer(
+                device,
+                timestamp: samples.timestamps[index],
+                ax: samples.x[index],
+                ay: samples.y[index],
+                az: samples.z[index]
+            )
+        }
+    }
+
+    func didReceiveGyroscope(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceiveGyroscope(
+                device,
+                timestamp: samples.timestamps[index],
+                gx: samples.x[index],
+                gy: samples.y[index],
+                gz: samples.z[index]
+            )
+        }
+    }
+
+    func didReceiveMagnetometer(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceiveMagnetometer(
+                device,
+                timestamp: samples.timestamps[index],
+                mx: samples.x[index],
+                my: samples.y[index],
+                mz: samples.z[index]
+            )
+        }
+    }
+
+    func didReceiveQuaternion(_ device: Device, samples: QuaternionBlock) {
+        for index in 0 ..< samples.count {
+            didReceiveQuaternion(
+                device,
+                timestamp: samples.timestamps[index],
+                qw: samples.w[index],
+                qx: samples.x[index],
+                qy: samples.y[index],
+                qz: samples.z[index]
+            )
+        }
+    }
+
+    func didReceivePastAccelerometer(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceivePastAccelerometer(
+                device,
+                timestamp: samples.timestamps[index],
+                ax: samples.x[index],
+                ay: samples.y[index],
+                az: samples.z[index]
+            )
+        }
+    }
+
+    func didReceivePastGyroscope(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceivePastGyroscope(
+                device,
+                timestamp: samples.timestamps[index],
+                gx: samples.x[index],
+                gy: samples.y[index],
+                gz: samples.z[index]
+            )
+        }
+    }
+
+    func didReceivePastMagnetometer(_ device: Device, samples: VectorBlock) {
+        for index in 0 ..< samples.count {
+            didReceivePastMagnetometer(
+                device,
+                timestamp: samples.timestamps[index],
+                mx: samples.x[index],
+                my: samples.y[index],
+                mz: samples.z[index]
+            )
+        }
+    }
+
+    func didReceivePastQuaternion(_ device: Device, samples: QuaternionBlock) {
+        for index in 0 ..< samples.count {
+            didReceivePastQuaternion(
+                device,
+                timestamp: samples.timestamps[index],
+                qw: samples.w[index],
+                qx: samples.x[index],
+                qy: samples.y[index],
+                qz: samples.z[index]
+            )
+        }
+    }
 }
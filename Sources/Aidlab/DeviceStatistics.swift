@@ -0,0 +1,90 @@
+import Foundation
+
+/// Counters of one device since it was created or since `Device.resetStatistics()`.
+public struct DeviceStatistics: Sendable {
+    /// Notifications handed to the decoder: command chunks, legacy characteristic packets and battery packets.
+    public var chunksProcessed: UInt64 = 0
+    public var bytesReceived: UInt64 = 0
+    /// Frames the SDK emitted towards the device.
+    public var framesSent: UInt64 = 0
+    public var bytesSent: UInt64 = 0
+    /// Errors reported by the decoder, such as CRC or reassembly failures.
+    public var protocolErrors: UInt64 = 0
+    /// Outgoing frames that failed: write errors, frames rejected by the SDK and confirmation timeouts.
+    public var transportErrors: UInt64 = 0
+    /// Time spent inside the decoder, including event callbacks the decoder fires synchronously.
+    public var decodeNanoseconds: UInt64 = 0
+    /// Time spent delivering sample blocks to the delegate.
+    public var callbackNanoseconds: UInt64 = 0
+
+    fileprivate static let dataTypeSlots = 32
+    fileprivate var sampleCounts = [UInt64](repeating: 0, count: dataTypeSlots)
+
+    /// Samples or events of `dataType` delivered to the delegate. Motion covers accelerometer, gyroscope,
+    /// magnetometer and quaternion samples.
+    public func samples(of dataType: DataType) -> UInt64 {
+        sampleCounts[dataType.rawValue]
+    }
+
+    public var totalSamples: UInt64 {
+        sampleCounts.reduce(0, +)
+    }
+}
+
+/// Accumulates the `DeviceStatistics` of one device.
+///
+/// Sample counts are gathered without locking on the thread that drives the SDK instance and merged under
+/// the lock once per chunk, so the per-sample cost is a single increment.
+final class StatisticsCollector: @unchecked Sendable {
+    private let lock = NSLock()
+    private var statistics = DeviceStatistics()
+    private var chunkSampleCounts = [UInt64](repeating: 0, count: DeviceStatistics.dataTypeSlots)
+
+    var snapshot: DeviceStatistics {
+        lock.lock()
+        defer { lock.unlock() }
+        return statistics
+    }
+
+    func reset() {
+        lock.lock()
+        statistics = DeviceStatistics()
+        lock.unlock()
+    }
+
+    func countSample(_ dataType: DataType) {
+        chunkSampleCounts[dataType.rawValue] &+= 1
+    }
+
+    func recordChunk(byteCount: Int, decodeNanoseconds: UInt64, callbackNanoseconds: UInt64) {
+        lock.lock()
+        statistics.chunksProcessed &+= 1
+        statistics.bytesReceived &+= UInt64(byteCount)
+        statistics.decodeNanoseconds &+= decodeNanoseconds
+        statistics.callbackNanoseconds &+= callbackNanoseconds
+        for index in chunkSampleCounts.indices where chunkSampleCounts[index] != 0 {
+            statistics.sampleCounts[index] &+= chunkSampleCounts[index]
+            chunkSampleCounts[index] = 0
+        }
+        lock.unlock()
+    }
+
+    func recordFrameSent(byteCount: Int) {
+        lock.lock()
+        statistics.framesSent &+= 1
+        statistics.bytesSent &+= UInt64(byteCount)
+        lock.unlock()
+    }
+
+    func recordProtocolError() {
+        lock.lock()
+        statistics.protocolErrors &+= 1
+        lock.unlock()
+    }
+
+    func recordTransportError() {
+        lock.lock()
+        statistics.transportErrors &+= 1
+        lock.unlock()
+    }
+}
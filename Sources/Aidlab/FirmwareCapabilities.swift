@@ -0,0 +1,51 @@
+import Foundation
+
+/// Protocol features of a firmware revision. They are parsed once when `Device.firmwareRevision` is set, so
+/// the send and collect paths branch on flags instead of re-parsing the revision string.
+public struct FirmwareCapabilities: Sendable, Equatable {
+    /// Capabilities of a device whose firmware revision is unknown or not a `major.minor.patch` version.
+    public static let unknown = FirmwareCapabilities(version: nil)
+
+    /// Whether the revision parsed as `major.minor.patch`, ignoring any `-suffix`.
+    public let isRecognized: Bool
+    /// Frames are sent as writes without response and acknowledged by the device (firmware 4.0.0 and later).
+    public let usesV4Protocol: Bool
+    /// `collect` runs as a device process instead of per-characteristic notifications (3.6.0 and later).
+    public let supportsProcessCollection: Bool
+    /// `collect` takes hexadecimal flag strings instead of a binary payload (3.7.80 and later).
+    public let collectsWithFlagStrings: Bool
+    /// `sync fast` is available (3.7.83 and later).
+    public let supportsFastSync: Bool
+    /// `collect` also spawns a sync process that must be tracked (3.7.85 to 3.7.110).
+    public let hasCollectAutoSyncBug: Bool
+    /// Largest command chunk the firmware accepts; the negotiated MTU may lower it further.
+    public let maxCommandChunkLength: Int
+    /// Whether this SDK supports the firmware's minor version.
+    public let isCompatible: Bool
+
+    public init(revision: String?) {
+        let sanitized = revision.map { $0.split(separator: "-").first.map(String.init) ?? $0 }
+        self.init(version: sanitized.flatMap(SemVersion.init))
+    }
+
+    init(version: SemVersion?) {
+        isRecognized = version != nil
+        guard let version else {
+            usesV4Protocol = false
+            supportsProcessCollection = false
+            collectsWithFlagStrings = false
+            supportsFastSync = false
+            hasCollectAutoSyncBug = false
+            maxCommandChunkLength = 20
+            isCompatible = true
+            return
+        }
+        usesV4Protocol = version >= SemVersion(4, 0, 0)
+        supportsProcessCollection = version >= SemVersion(3, 6, 0)
+        collectsWithFlagStrings = version >= SemVersion(3, 7, 80)
+        supportsFastSync = version >= SemVersion(3, 7, 83)
+        hasCollectAutoSyncBug = version >= SemVersion(3, 7, 85) && version <= SemVersion(3, 7, 110)
+        maxCommandChunkLength = usesV4Protocol ? 512 : 20
+        isCompatible = Config.supportedAidlabVersion >= version.minor
+    }
+}
@@ -0,0 +1,37 @@
+import AidlabSDK
+@preconcurrency import CoreBluetooth
+import Foundation
+
+/// A characteristic that streams one kind of packet outside the command channel, with the record kind it is
+/// captured as and the SDK entry point that decodes it. This is the only place the three are matched up; the
+/// device, the capture and the simulator all look them up here.
+struct LegacyCharacteristic: @unchecked Sendable {
+    typealias Decoder = @convention(c) (UnsafePointer<UInt8>?, Int32, UnsafeMutableRawPointer?) -> Void
+
+    let uuid: CBUUID
+    let kind: ChunkCapture.Kind
+    let decoder: Decoder
+
+    /// Where two UUIDs share a kind, the first is the one a capture record is replayed on.
+    static let all: [LegacyCharacteristic] = [
+        LegacyCharacteristic(uuid: ecgCharacteristicUUID, kind: .legacyECG, decoder: processECGPackage),
+        LegacyCharacteristic(uuid: temperatureCharacteristicUUID, kind: .legacyTemperature, decoder: processTemperaturePackage),
+        LegacyCharacteristic(uuid: respirationCharacteristicUUID, kind: .legacyRespiration, decoder: processRespirationPackage),
+        LegacyCharacteristic(uuid: motionCharacteristicUUID, kind: .legacyMotion, decoder: processMotionPackage),
+        LegacyCharacteristic(uuid: soundVolumeCharacteristicUUID, kind: .legacySoundVolume, decoder: processSoundVolumePackage),
+        LegacyCharacteristic(uuid: MotionService.stepsUUID, kind: .legacySteps, decoder: processStepsPackage),
+        LegacyCharacteristic(uuid: MotionService.activityUUID, kind: .legacyActivity, decoder: processActivityPackage),
+        LegacyCharacteristic(uuid: MotionService.orientationUUID, kind: .legacyOrientation, decoder: processOrientationPackage),
+        LegacyCharacteristic(uuid: HeartRateService.heartRateMeasurementCharacteristic, kind: .legacyHeartRate, decoder: processHeartRatePackage),
+        LegacyCharacteristic(uuid: BatteryLevelService.batteryLevelCharacteristic, kind: .battery, decoder: AidlabSDK_process_battery_package),
+        LegacyCharacteristic(uuid: batteryCharacteristicUUID, kind: .battery, decoder: AidlabSDK_process_battery_package)
+    ]
+
+    static func characteristic(for uuid: CBUUID) -> LegacyCharacteristic? {
+        all.first { $0.uuid == uuid }
+    }
+
+    static func characteristic(for kind: ChunkCapture.Kind) -> LegacyCharacteristic? {
+        all.first { $0.kind == kind }
+    }
+}
@@ -0,0 +1,133 @@
+import Foundation
+
+/// Source of the memory behind a device's sample block buffers.
+///
+/// `Device.init(transport:allocator:)` takes one. Buffers grow by doubling and are kept for the lifetime of the
+/// device, so a steady session allocates only during its first seconds.
+protocol SampleAllocator: AnyObject, Sendable {
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer
+    func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount: Int)
+}
+
+/// Allocates straight from the process heap.
+final class SystemSampleAllocator: SampleAllocator {
+    static let shared = SystemSampleAllocator()
+
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer {
+        UnsafeMutableRawPointer.allocate(byteCount: byteCount, alignment: alignment)
+    }
+
+    func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount _: Int) {
+        pointer.deallocate()
+    }
+}
+
+/// Fixed-size region carved up for sample buffers, shareable by many devices.
+///
+/// Freed blocks are kept on a free list per size and handed out again, so devices that disconnect and reconnect
+/// reuse the same memory instead of fragmenting the heap. When the region is exhausted, allocations fall back
+/// to the process heap and are counted in `overflowCount`.
+final class SampleArena: SampleAllocator, @unchecked Sendable {
+    let capacity: Int
+
+    private let lock = NSLock()
+    private let base: UnsafeMutableRawPointer
+    private var used = 0
+    private var freeBlocks: [Int: [UnsafeMutableRawPointer]] = [:]
+    private var overflows = 0
+
+    init(capacity: Int) {
+        self.capacity = capacity
+        base = UnsafeMutableRawPointer.allocate(byteCount: capacity, alignment: VectorBlock.alignment)
+    }
+
+    deinit {
+        base.deallocate()
+    }
+
+    /// Bytes of the region handed out so far, including blocks now on the free lists.
+    var usedBytes: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return used
+    }
+
+    /// Allocations that did not fit into the region.
+    var overflowCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return overflows
+    }
+
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard alignment <= VectorBlock.alignment else {
+            overflows += 1
+            return UnsafeMutableRawPointer.allocate(byteCount: byteCount, alignment: alignment)
+        }
+        // A freed block only has the alignment it was requested with.
+        if let index = freeBlocks[byteCount]?.lastIndex(where: { Int(bitPattern: $0) % alignment == 0 }),
+           let pointer = freeBlocks[byteCount]?.remove(at: index) {
+            return pointer
+        }
+        let start = (used + alignment - 1) / alignment * alignment
+        guard start + byteCount <= capacity else {
+            overflows += 1
+            return UnsafeMutableRawPointer.allocate(byteCount: byteCount, alignment: alignment)
+        }
+        used = start + byteCount
+        return base + start
+    }
+
+    func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount: Int) {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard pointer >= base, pointer < base + capacity else {
+            pointer.deallocate()
+            return
+        }
+        freeBlocks[byteCount, default: []].append(pointer)
+    }
+}
+
+/// Memory held by a device's sample buffers.
+struct MemoryFootprint: Sendable {
+    var currentBytes: Int
+    var peakBytes: Int
+}
+
+/// Allocator of one device plus the running totals behind `Device.memoryFootprint`.
+final class SampleMemory: @unchecked Sendable {
+    let allocator: SampleAllocator
+
+    private let lock = NSLock()
+    private var footprint = MemoryFootprint(currentBytes: 0, peakBytes: 0)
+
+    init(allocator: SampleAllocator = SystemSampleAllocator.shared) {
+        self.allocator = allocator
+    }
+
+    var currentFootprint: MemoryFootprint {
+        lock.lock()
+        defer { lock.unlock() }
+        return footprint
+    }
+
+    func allocate(byteCount: Int, alignment: Int) -> UnsafeMutableRawPointer {
+        lock.lock()
+        footprint.currentBytes += byteCount
+        footprint.peakBytes = max(footprint.peakBytes, footprint.currentBytes)
+        lock.unlock()
+        return allocator.allocate(byteCount: byteCount, alignment: alignment)
+    }
+
+    func deallocate(_ pointer: UnsafeMutableRawPointer, byteCount: Int) {
+        lock.lock()
+        footprint.currentBytes -= byteCount
+        lock.unlock()
+        allocator.deallocate(pointer, byteCount: byteCount)
+    }
+}
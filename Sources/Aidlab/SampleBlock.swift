@@ -0,0 +1,182 @@
+import Foundation
+
+/// A contiguous run of single-channel samples decoded from one BLE chunk.
+///
+/// The buffers are owned by the `Device` and are only valid for the duration of the delegate call.
+/// Copy them (e.g. `Array(block.values)`) if you need to keep the data.
+public struct SampleBlock {
+    public let timestamps: UnsafeBufferPointer<UInt64>
+    public let values: UnsafeBufferPointer<Float>
+
+    public var count: Int { values.count }
+
+    /// Timestamp of the first sample in the block.
+    public var baseTimestamp: UInt64 { timestamps.first ?? 0 }
+
+    /// Mean spacing between consecutive samples in timestamp units, or 0 for blocks shorter than two samples.
+    public var samplePeriod: Double {
+        guard let first = timestamps.first, let last = timestamps.last, count > 1 else { return 0 }
+        return Double(last &- first) / Double(count - 1)
+    }
+}
+
+/// Structure-of-arrays view over 3-axis samples (accelerometer, gyroscope, magnetometer) decoded from one BLE chunk.
+///
+/// Every column starts on a `VectorBlock.alignment`-byte boundary so it can be fed to SIMD kernels as is.
+/// The buffers are only valid for the duration of the delegate call.
+public struct VectorBlock {
+    /// Byte alignment of every column; covers NEON, AVX-512 and a cache line.
+    public static let alignment = 64
+
+    public let timestamps: UnsafeBufferPointer<UInt64>
+    public let x: UnsafeBufferPointer<Float>
+    public let y: UnsafeBufferPointer<Float>
+    public let z: UnsafeBufferPointer<Float>
+
+    public var count: Int { timestamps.count }
+}
+
+/// Structure-of-arrays view over quaternion samples decoded from one BLE chunk.
+///
+/// Columns have the same alignment and lifetime guarantees as `VectorBlock`.
+public struct QuaternionBlock {
+    public static let alignment = VectorBlock.alignment
+
+    public let timestamps: UnsafeBufferPointer<UInt64>
+    public let w: UnsafeBufferPointer<Float>
+    public let x: UnsafeBufferPointer<Float>
+    public let y: UnsafeBufferPointer<Float>
+    public let z: UnsafeBufferPointer<Float>
+
+    public var count: Int { timestamps.count }
+}
+
+/// Growable, aligned column storage backing the block types above.
+///
+/// Not thread-safe; a buffer is filled and flushed on the thread that drives the SDK instance.
+final class SampleBlockBuffer {
+    static let alignment = VectorBlock.alignment
+
+    private(set) var count = 0
+    /// Host receive time of the chunk that contributed the first sample since the last flush; kept by `Device`.
+    var firstReceivedAt: UInt64 = 0
+    private var capacity: Int
+    private let memory: SampleMemory
+    private var timestamps: UnsafeMutablePointer<UInt64>
+    private var columns: [UnsafeMutablePointer<Float>]
+
+    var columnCount: Int { columns.count }
+
+    init(columnCount: Int = 1, capacity: Int = 256, memory: SampleMemory = SampleMemory()) {
+        self.capacity = capacity
+        self.memory = memory
+        timestamps = Self.allocateColumn(UInt64.self, capacity: capacity, memory: memory)
+        columns = (0 ..< columnCount).map { _ in Self.allocateColumn(Float.self, capacity: capacity, memory: memory) }
+    }
+
+    deinit {
+        Self.deallocateColumn(timestamps, capacity: capacity, memory: memory)
+        for column in columns {
+            Self.deallocateColumn(column, capacity: capacity, memory: memory)
+        }
+    }
+
+    var isEmpty: Bool { count == 0 }
+
+    func append(_ timestamp: UInt64, _ value: Float) {
+        reserveNext()
+        timestamps[count] = timestamp
+        columns[0][count] = value
+        count += 1
+    }
+
+    func append(_ timestamp: UInt64, _ x: Float, _ y: Float, _ z: Float) {
+        reserveNext()
+        timestamps[count] = timestamp
+        columns[0][count] = x
+        columns[1][count] = y
+        columns[2][count] = z
+        count += 1
+    }
+
+    func append(_ timestamp: UInt64, _ w: Float, _ x: Float, _ y: Float, _ z: Float) {
+        reserveNext()
+        timestamps[count] = timestamp
+        columns[0][count] = w
+        columns[1][count] = x
+        columns[2][count] = y
+        columns[3][count] = z
+        count += 1
+    }
+
+    // Block views below are invalidated by the next `append` or `removeAll`.
+
+    var block: SampleBlock {
+        SampleBlock(timestamps: timestampColumn, values: column(0))
+    }
+
+    var vectorBlock: VectorBlock {
+        VectorBlock(timestamps: timestampColumn, x: column(0), y: column(1), z: column(2))
+    }
+
+    var quaternionBlock: QuaternionBlock {
+        QuaternionBlock(timestamps: timestampColumn, w: column(0), x: column(1), y: column(2), z: column(3))
+    }
+
+    /// Appends every sample of `other`, which must have the same number of columns.
+    func append(contentsOf other: SampleBlockBuffer) {
+        precondition(other.columnCount == columnCount, "Column count mismatch")
+        while capacity - count < other.count {
+            grow()
+        }
+        (timestamps + count).initialize(from: other.timestamps, count: other.count)
+        for index in columns.indices {
+            (columns[index] + count).initialize(from: other.columns[index], count: other.count)
+        }
+        count += other.count
+    }
+
+    func removeAll() {
+        count = 0
+    }
+
+    var timestampColumn: UnsafeBufferPointer<UInt64> {
+        UnsafeBufferPointer(start: timestamps, count: count)
+    }
+
+    func column(_ index: Int) -> UnsafeBufferPointer<Float> {
+        UnsafeBufferPointer(start: columns[index], count: count)
+    }
+
+    private func reserveNext() {
+        if count == capacity {
+            grow()
+        }
+    }
+
+    private func grow() {
+        let newCapacity = capacity * 2
+        timestamps = reallocateColumn(timestamps, newCapacity: newCapacity)
+        for index in columns.indices {
+            columns[index] = reallocateColumn(columns[index], newCapacity: newCapacity)
+        }
+        capacity = newCapacity
+    }
+
+    private func reallocateColumn<T>(_ column: UnsafeMutablePointer<T>, newCapacity: Int) -> UnsafeMutablePointer<T> {
+        let newColumn = Self.allocateColumn(T.self, capacity: newCapacity, memory: memory)
+        newColumn.moveInitialize(from: column, count: count)
+        Self.deallocateColumn(column, capacity: capacity, memory: memory)
+        return newColumn
+    }
+
+    private static func allocateColumn<T>(_: T.Type, capacity: Int, memory: SampleMemory) -> UnsafeMutablePointer<T> {
+        memory
+            .allocate(byteCount: capacity * MemoryLayout<T>.stride, alignment: alignment)
+            .bindMemory(to: T.self, capacity: capacity)
+    }
+
+    private static func deallocateColumn<T>(_ column: UnsafeMutablePointer<T>, capacity: Int, memory: SampleMemory) {
+        memory.deallocate(UnsafeMutableRawPointer(column), byteCount: capacity * MemoryLayout<T>.stride)
+    }
+}
@@ -0,0 +1,159 @@
+import Foundation
+
+/// Bounded single-producer/single-consumer queue of one signal's samples, filled by `Device` in place of the
+/// delegate's block callbacks while `Device.sampleRings` is set.
+///
+/// The decoding thread is the only producer and copies into free slots without holding the lock; one consumer
+/// thread drains at its own pace. Only the read and write positions are exchanged under the lock, a few loads and
+/// stores per block, since the deployment targets predate the standard library's atomics. When the consumer falls
+/// behind, samples that do not fit are dropped and counted in `overflowCount`; the producer never waits.
+public final class SampleRing: @unchecked Sendable {
+    /// Contiguous run of samples in ring storage, valid only inside `drain`.
+    public struct Segment {
+        public let timestamps: UnsafeBufferPointer<UInt64>
+        private let values: UnsafePointer<Float>
+        private let stride: Int
+
+        fileprivate init(timestamps: UnsafeBufferPointer<UInt64>, values: UnsafePointer<Float>, stride: Int) {
+            self.timestamps = timestamps
+            self.values = values
+            self.stride = stride
+        }
+
+        public var count: Int { timestamps.count }
+
+        /// Axis `index` in the order of the corresponding block type (`values`, `x/y/z` or `w/x/y/z`).
+        public func column(_ index: Int) -> UnsafeBufferPointer<Float> {
+            UnsafeBufferPointer(start: values + index * stride, count: timestamps.count)
+        }
+    }
+
+    public let signal: WaveformSignal
+    public let capacity: Int
+
+    private let lock = NSLock()
+    private var writePosition = 0
+    private var readPosition = 0
+    private var droppedSamples: UInt64 = 0
+    private let timestamps: UnsafeMutablePointer<UInt64>
+    /// Column-major: axis `c` of slot `s` lives at `c * capacity + s`.
+    private let values: UnsafeMutablePointer<Float>
+
+    init(signal: WaveformSignal, capacity: Int) {
+        self.signal = signal
+        self.capacity = max(1, capacity)
+        timestamps = .allocate(capacity: self.capacity)
+        values = .allocate(capacity: self.capacity * signal.columnCount)
+    }
+
+    deinit {
+        timestamps.deallocate()
+        values.deallocate()
+    }
+
+    /// Samples waiting to be drained.
+    public var count: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return writePosition - readPosition
+    }
+
+    /// Samples dropped because the ring was full.
+    public var overflowCount: UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        return droppedSamples
+    }
+
+    /// Consumer side: passes up to `maxCount` of the oldest samples to `body` as at most two segments, oldest
+    /// first, then releases their slots. Returns the number of samples drained.
+    @discardableResult
+    public func drain(maxCount: Int = .max, _ body: (Segment) throws -> Void) rethrows -> Int {
+        lock.lock()
+        let start = readPosition
+        let available = min(maxCount, writePosition - readPosition)
+        lock.unlock()
+        guard available > 0 else { return 0 }
+
+        let slot = start % capacity
+        let head = min(available, capacity - slot)
+        try body(segment(from: slot, count: head))
+        if head < available {
+            try body(segment(from: 0, count: available - head))
+        }
+
+        lock.lock()
+        readPosition += available
+        lock.unlock()
+        return available
+    }
+
+    /// Producer side, called on the thread that drives the SDK instance.
+    func push(_ buffer: SampleBlockBuffer) {
+        lock.lock()
+        let start = writePosition
+        let free = capacity - (writePosition - readPosition)
+        lock.unlock()
+
+        let accepted = min(free, buffer.count)
+        if accepted > 0 {
+            let slot = start % capacity
+            let head = min(accepted, capacity - slot)
+            copy(buffer, from: 0, to: slot, count: head)
+            copy(buffer, from: head, to: 0, count: accepted - head)
+        }
+
+        lock.lock()
+        writePosition += accepted
+        droppedSamples &+= UInt64(buffer.count - accepted)
+        lock.unlock()
+    }
+
+    private func copy(_ buffer: SampleBlockBuffer, from source: Int, to slot: Int, count: Int) {
+        guard count > 0 else { return }
+        guard let bufferTimestamps = buffer.timestampColumn.baseAddress else {
+            preconditionFailure("Non-empty sample block without storage")
+        }
+        (timestamps + slot).update(from: bufferTimestamps + source, count: count)
+        for index in 0 ..< signal.columnCount {
+            guard let column = buffer.column(index).baseAddress else {
+                preconditionFailure("Non-empty sample block without storage")
+            }
+            (values + index * capacity + slot).update(from: column + source, count: count)
+        }
+    }
+
+    private func segment(from slot: Int, count: Int) -> Segment {
+        Segment(
+            timestamps: UnsafeBufferPointer(start: timestamps + slot, count: count),
+            values: values + slot,
+            stride: capacity
+        )
+    }
+}
+
+/// Rings for the signals an application drains itself, for `Device.sampleRings`. Signals without a ring are still
+/// delivered to the delegate.
+public final class SampleRings: @unchecked Sendable {
+    private let rings: [WaveformSignal: SampleRing]
+
+    /// - Parameters:
+    ///   - signals: Signals to route into rings; storage is allocated up front for these only.
+    ///   - capacity: Samples each ring holds before it starts dropping.
+    public init(signals: [WaveformSignal], capacity: Int = 1 << 14) {
+        var rings: [WaveformSignal: SampleRing] = [:]
+        for signal in signals where rings[signal] == nil {
+            rings[signal] = SampleRing(signal: signal, capacity: capacity)
+        }
+        self.rings = rings
+    }
+
+    public subscript(signal: WaveformSignal) -> SampleRing? {
+        rings[signal]
+    }
+
+    /// Samples dropped across all rings.
+    public var overflowCount: UInt64 {
+        rings.values.reduce(0) { $0 &+ $1.overflowCount }
+    }
+}
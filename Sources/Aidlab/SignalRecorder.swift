@@ -0,0 +1,355 @@
+import Foundation
+
+/// File-format tags of the signals stored by `SignalRecorder`. Raw values are part of the file format; everywhere
+/// else signals are `WaveformSignal`.
+public enum RecordedSignal: UInt8, CaseIterable, Sendable {
+    case ecg = 0
+    case respiration = 1
+    case skinTemperature = 2
+    case accelerometer = 3
+    case gyroscope = 4
+    case magnetometer = 5
+    case quaternion = 6
+    case pastECG = 16
+    case pastRespiration = 17
+    case pastSkinTemperature = 18
+    case pastAccelerometer = 19
+    case pastGyroscope = 20
+    case pastMagnetometer = 21
+    case pastQuaternion = 22
+
+    public init(_ signal: WaveformSignal) {
+        self = switch signal {
+        case .ecg: .ecg
+        case .respiration: .respiration
+        case .skinTemperature: .skinTemperature
+        case .accelerometer: .accelerometer
+        case .gyroscope: .gyroscope
+        case .magnetometer: .magnetometer
+        case .quaternion: .quaternion
+        case .pastECG: .pastECG
+        case .pastRespiration: .pastRespiration
+        case .pastSkinTemperature: .pastSkinTemperature
+        case .pastAccelerometer: .pastAccelerometer
+        case .pastGyroscope: .pastGyroscope
+        case .pastMagnetometer: .pastMagnetometer
+        case .pastQuaternion: .pastQuaternion
+        }
+    }
+
+    public var signal: WaveformSignal {
+        switch self {
+        case .ecg: .ecg
+        case .respiration: .respiration
+        case .skinTemperature: .skinTemperature
+        case .accelerometer: .accelerometer
+        case .gyroscope: .gyroscope
+        case .magnetometer: .magnetometer
+        case .quaternion: .quaternion
+        case .pastECG: .pastECG
+        case .pastRespiration: .pastRespiration
+        case .pastSkinTemperature: .pastSkinTemperature
+        case .pastAccelerometer: .pastAccelerometer
+        case .pastGyroscope: .pastGyroscope
+        case .pastMagnetometer: .pastMagnetometer
+        case .pastQuaternion: .pastQuaternion
+        }
+    }
+
+    public var columnCount: Int { signal.columnCount }
+
+    public var dataType: DataType { signal.dataType }
+}
+
+/// Writes decoded sample blocks into a compressed columnar file.
+///
+/// Attach it with `Device.recorder`, one recorder per device: a recorder owns one file, and samples of two devices
+/// would interleave in its per-signal blocks. Samples are grouped per signal into blocks of `samplesPerBlock`.
+/// Each block stores its timestamps as zig-zag varint deltas followed by one little-endian `Float` column per
+/// axis, deflate-compressed. Read the file back with `SignalRecording`.
+///
+/// The decoding thread only encodes a full block; compression and the file write run on the recorder's own serial
+/// queue. Blocks that fail to write are skipped and counted in `failedBlockCount`.
+///
+/// File layout (little-endian):
+///
+///     "ALSR" | version: u8
+///     repeated: signal: u8 | count: u32 | baseTimestamp: u64 | rawLength: u32 | compressedLength: u32 | payload
+public final class SignalRecorder: @unchecked Sendable {
+    static let magic: [UInt8] = Array("ALSR".utf8)
+    static let version: UInt8 = 1
+    static let blockHeaderLength = 21
+
+    public let samplesPerBlock: Int
+
+    private let lock = NSLock()
+    private let writer: BlockWriter
+    private var pending: [RecordedSignal: SampleBlockBuffer] = [:]
+    private var isClosed = false
+
+    public init(url: URL, samplesPerBlock: Int = 4096) throws {
+        guard FileManager.default.createFile(atPath: url.path, contents: Data(SignalRecorder.magic + [SignalRecorder.version])) else {
+            throw AidlabError(message: "Cannot create recording at \(url.path)")
+        }
+        let fileHandle = try FileHandle(forWritingTo: url)
+        try fileHandle.seekToEnd()
+        writer = BlockWriter(fileHandle: fileHandle)
+        self.samplesPerBlock = max(1, samplesPerBlock)
+    }
+
+    deinit {
+        try? close()
+    }
+
+    /// Full blocks that could not be compressed or written and are missing from the file.
+    public var failedBlockCount: Int {
+        writer.failedBlockCount
+    }
+
+    /// Waits for the blocks already handed to the I/O queue, writes the remaining partial blocks and closes the
+    /// file.
+    public func close() throws {
+        lock.lock()
+        guard !isClosed else {
+            lock.unlock()
+            return
+        }
+        isClosed = true
+        let remaining = RecordedSignal.allCases.compactMap { signal in
+            pending[signal].flatMap { $0.isEmpty ? nil : EncodedBlock(signal, $0) }
+        }
+        pending.removeAll()
+        lock.unlock()
+
+        try writer.close(writingFirst: remaining)
+    }
+
+    func record(_ signal: WaveformSignal, _ samples: SampleBlockBuffer) {
+        let signal = RecordedSignal(signal)
+        lock.lock()
+        defer { lock.unlock() }
+        guard !isClosed else { return }
+
+        let buffer: SampleBlockBuffer
+        if let existing = pending[signal] {
+            buffer = existing
+        } else {
+            buffer = SampleBlockBuffer(columnCount: signal.columnCount, capacity: samplesPerBlock)
+            pending[signal] = buffer
+        }
+        buffer.append(contentsOf: samples)
+        if buffer.count >= samplesPerBlock {
+            writer.enqueue(EncodedBlock(signal, buffer))
+            buffer.removeAll()
+        }
+    }
+}
+
+/// Owns the recording's file handle, which is only touched on its serial queue. Kept apart from `SignalRecorder`
+/// so queued writes never hold the recorder, whose `deinit` waits for them.
+private final class BlockWriter: @unchecked Sendable {
+    private let queue = DispatchQueue(label: "com.aidlab.signal-recorder")
+    private let fileHandle: FileHandle
+    private let lock = NSLock()
+    private var failedBlocks = 0
+
+    init(fileHandle: FileHandle) {
+        self.fileHandle = fileHandle
+    }
+
+    var failedBlockCount: Int {
+        lock.lock()
+        defer { lock.unlock() }
+        return failedBlocks
+    }
+
+    func enqueue(_ block: EncodedBlock) {
+        queue.async {
+            do {
+                try self.fileHandle.write(contentsOf: block.serialized())
+            } catch {
+                // Recording must not take the decode path down with it; the gap shows in `failedBlockCount`.
+                self.lock.lock()
+                self.failedBlocks += 1
+                self.lock.unlock()
+            }
+        }
+    }
+
+    func close(writingFirst blocks: [EncodedBlock]) throws {
+        try queue.sync {
+            for block in blocks {
+                try fileHandle.write(contentsOf: block.serialized())
+            }
+            try fileHandle.close()
+        }
+    }
+}
+
+/// One block with its columns laid out but not yet compressed.
+private struct EncodedBlock: Sendable {
+    let signal: RecordedSignal
+    let count: Int
+    let baseTimestamp: UInt64
+    let raw: Data
+
+    init(_ signal: RecordedSignal, _ buffer: SampleBlockBuffer) {
+        let timestamps = buffer.timestampColumn
+        var raw = Data(capacity: buffer.count * (2 + 4 * buffer.columnCount))
+        var previous = timestamps.first ?? 0
+        for timestamp in timestamps {
+            let delta = Int64(bitPattern: timestamp &- previous)
+            EncodedBlock.appendVarint(UInt64(bitPattern: (delta << 1) ^ (delta >> 63)), to: &raw)
+            previous = timestamp
+        }
+        for index in 0 ..< buffer.columnCount {
+            for value in buffer.column(index) {
+                withUnsafeBytes(of: value.bitPattern.littleEndian) { raw.append(contentsOf: $0) }
+            }
+        }
+        self.signal = signal
+        count = buffer.count
+        baseTimestamp = timestamps.first ?? 0
+        self.raw = raw
+    }
+
+    /// Header and deflate-compressed payload, as stored in the file.
+    func serialized() throws -> Data {
+        let compressed = try (raw as NSData).compressed(using: .zlib) as Data
+        var block = Data(capacity: SignalRecorder.blockHeaderLength + compressed.count)
+        block.append(signal.rawValue)
+        withUnsafeBytes(of: UInt32(count).littleEndian) { block.append(contentsOf: $0) }
+        withUnsafeBytes(of: baseTimestamp.littleEndian) { block.append(contentsOf: $0) }
+        withUnsafeBytes(of: UInt32(raw.count).littleEndian) { block.append(contentsOf: $0) }
+        withUnsafeBytes(of: UInt32(compressed.count).littleEndian) { block.append(contentsOf: $0) }
+        block.append(compressed)
+        return block
+    }
+
+    private static func appendVarint(_ value: UInt64, to data: inout Data) {
+        var value = value
+        while value >= 0x80 {
+            data.append(UInt8(truncatingIfNeeded: value) | 0x80)
+            value >>= 7
+        }
+        data.append(UInt8(value))
+    }
+}
+
+/// Memory-mapped reader for files written by `SignalRecorder`.
+///
+/// Opening a recording only indexes block headers; payloads are inflated on demand.
+public struct SignalRecording {
+    public struct Block {
+        public let signal: RecordedSignal
+        public let count: Int
+        public let baseTimestamp: UInt64
+        fileprivate let rawLength: Int
+        fileprivate let payload: Range<Int>
+    }
+
+    public struct Samples {
+        public var timestamps: [UInt64] = []
+        /// One array per axis, in the order of the corresponding block type (`values`, `x/y/z` or `w/x/y/z`).
+        public var columns: [[Float]]
+    }
+
+    public let blocks: [Block]
+    private let data: Data
+
+    public init(contentsOf url: URL) throws {
+        data = try Data(contentsOf: url, options: .alwaysMapped)
+        guard data.count >= 5, Array(data.prefix(4)) == SignalRecorder.magic else {
+            throw AidlabError(message: "Not a signal recording")
+        }
+        guard data[data.startIndex + 4] == SignalRecorder.version else {
+            throw AidlabError(message: "Unsupported signal recording version")
+        }
+
+        var blocks: [Block] = []
+        var offset = data.startIndex + 5
+        while offset < data.endIndex {
+            guard data.endIndex - offset >= SignalRecorder.blockHeaderLength else {
+                throw AidlabError(message: "Truncated signal recording block at byte \(offset)")
+            }
+            let compressedLength = Int(data.littleEndianInteger(UInt32.self, at: offset + 17))
+            let payloadStart = offset + SignalRecorder.blockHeaderLength
+            guard compressedLength <= data.endIndex - payloadStart else {
+                throw AidlabError(message: "Truncated signal recording block at byte \(offset)")
+            }
+            if let signal = RecordedSignal(rawValue: data[offset]) {
+                blocks.append(
+                    Block(
+                        signal: signal,
+                        count: Int(data.littleEndianInteger(UInt32.self, at: offset + 1)),
+                        baseTimestamp: data.littleEndianInteger(UInt64.self, at: offset + 5),
+                        rawLength: Int(data.littleEndianInteger(UInt32.self, at: offset + 13)),
+                        payload: payloadStart ..< payloadStart + compressedLength
+                    )
+                )
+            }
+            offset = payloadStart + compressedLength
+        }
+        self.blocks = blocks
+    }
+
+    public func samples(in block: Block) throws -> Samples {
+        let raw = try [UInt8]((data.subdata(in: block.payload) as NSData).decompressed(using: .zlib) as Data)
+        guard raw.count == block.rawLength else {
+            throw AidlabError(message: "Corrupted signal recording block")
+        }
+
+        var samples = Samples(columns: [])
+        samples.timestamps.reserveCapacity(block.count)
+        var offset = 0
+        var timestamp = block.baseTimestamp
+        for _ in 0 ..< block.count {
+            var zigzag: UInt64 = 0
+            var shift: UInt64 = 0
+            while offset < raw.count {
+                let byte = raw[offset]
+                offset += 1
+                zigzag |= UInt64(byte & 0x7F) << shift
+                shift += 7
+                if byte < 0x80 { break }
+            }
+            let delta = Int64(bitPattern: zigzag >> 1) ^ -Int64(bitPattern: zigzag & 1)
+            timestamp = timestamp &+ UInt64(bitPattern: delta)
+            samples.timestamps.append(timestamp)
+        }
+
+        guard raw.count - offset == block.count * 4 * block.signal.columnCount else {
+            throw AidlabError(message: "Corrupted signal recording block")
+        }
+        for _ in 0 ..< block.signal.columnCount {
+            var column = [Float]()
+            column.reserveCapacity(block.count)
+            for _ in 0 ..< block.count {
+                let bits = raw[offset ..< offset + 4].reversed().reduce(UInt32(0)) { $0 << 8 | UInt32($1) }
+                column.append(Float(bitPattern: bits))
+                offset += 4
+            }
+            samples.columns.append(column)
+        }
+        return samples
+    }
+
+    /// All samples of `signal`, concatenated in file order.
+    public func samples(of signal: RecordedSignal) throws -> Samples {
+        var result = Samples(columns: Array(repeating: [], count: signal.columnCount))
+        for block in blocks where block.signal == signal {
+            let samples = try samples(in: block)
+            result.timestamps += samples.timestamps
+            for index in result.columns.indices {
+                result.columns[index] += samples.columns[index]
+            }
+        }
+        return result
+    }
+}
+
+private extension Data {
+    func littleEndianInteger<T: FixedWidthInteger>(_: T.Type, at offset: Int) -> T {
+        self[offset ..< offset + MemoryLayout<T>.size].reversed().reduce(T(0)) { $0 << 8 | T($1) }
+    }
+}
@@ -0,0 +1,247 @@
+@preconcurrency import CoreBluetooth
+import Foundation
+
+/// In-process stand-in for a strap, driven by a recorded `ChunkCapture`, for load tests without radio hardware.
+///
+/// Pass it to `Device(transport:)` and connect as usual. Notifications are replayed in capture order at the
+/// captured pace scaled by `speed`. Inbound records captured after an outbound frame are the device's answer
+/// to it: they are held back until the simulated device has received as many command bytes as that frame had.
+/// `collect`, `sync` and frame acknowledgements are therefore answered in the order the capture recorded them.
+/// Frames are matched by position and length, not by content.
+///
+/// All callbacks are delivered on `queue`.
+public final class SimulatedAidlabTransport: AidlabTransport, @unchecked Sendable {
+    public struct Configuration: Sendable {
+        /// Playback speed relative to the capture; 0 delivers every released notification immediately.
+        public var speed: Double = 1
+        public var mtuSize = 244
+        /// Command writes `Device` may keep in flight, as `AidlabTransport.writeWithoutResponseCredits`.
+        public var writeWithoutResponseCredits = 8
+        /// Probability of silently dropping each notification.
+        public var notificationLoss: Double = 0
+        /// Probability of failing each characteristic write.
+        public var writeFailureRate: Double = 0
+        /// Seed for the loss and failure draws, so runs are reproducible.
+        public var seed: UInt64 = 0
+        public var serialNumber = "SIMULATED"
+        public var hardwareRevision = "Simulated"
+
+        public init() {}
+    }
+
+    public let address = UUID()
+    public let name: String?
+    public var rssi: NSNumber = -50
+    public var onDisconnect: ((DisconnectReason, Error?) -> Void)?
+
+    public let configuration: Configuration
+    public let queue: DispatchQueue
+
+    public var mtuSize: Int { configuration.mtuSize }
+    public var writeWithoutResponseCredits: Int { configuration.writeWithoutResponseCredits }
+
+    private struct Pending {
+        let record: ChunkCapture.Record
+        let due: UInt64
+    }
+
+    private let firmwareRevision: String
+    /// Inbound records before the first outbound frame, then the answer to each outbound frame in turn.
+    private let segments: [[ChunkCapture.Record]]
+    private let frameLengths: [Int]
+
+    private var isConnected = false
+    private var generation = 0
+    private var random: SplitMix64
+    private var handlers: [CBUUID: (Data) -> Void] = [:]
+    private var releasedSegments = 0
+    private var receivedCommandBytes = 0
+    private var pending: [Pending] = []
+    private var pendingHead = 0
+
+    public init(
+        capture: ChunkCapture,
+        name: String? = "Aidlab Simulator",
+        configuration: Configuration = Configuration(),
+        queue: DispatchQueue = .main
+    ) {
+        self.name = name
+        self.configuration = configuration
+        self.queue = queue
+        firmwareRevision = capture.firmwareRevision
+        random = SplitMix64(seed: configuration.seed)
+
+        var segments: [[ChunkCapture.Record]] = [[]]
+        var frameLengths: [Int] = []
+        for record in capture.records {
+            if record.kind == .outboundFrame {
+                frameLengths.append(record.bytes.count)
+                segments.append([])
+            } else {
+                segments[segments.count - 1].append(record)
+            }
+        }
+        self.segments = segments
+        self.frameLengths = frameLengths
+    }
+
+    public func connect(completion: @escaping (Result<Void, Error>) -> Void) {
+        queue.async { [self] in
+            isConnected = true
+            generation += 1
+            releasedSegments = 0
+            receivedCommandBytes = 0
+            pending.removeAll()
+            pendingHead = 0
+            completion(.success(()))
+        }
+    }
+
+    public func disconnect() {
+        queue.async { [self] in
+            guard isConnected else { return }
+            isConnected = false
+            generation += 1
+            handlers.removeAll()
+            onDisconnect?(.appDisconnected, nil)
+        }
+    }
+
+    public func readCharacteristic(_ uuid: CBUUID, completion: @escaping (Result<Data, Error>) -> Void) {
+        queue.async { [self] in
+            let value: String? =
+                switch uuid {
+                case DeviceInformationService.manufacturerNameStringCharacteristic: "Aidlab"
+                case DeviceInformationService.serialNumberStringCharacteristic: configuration.serialNumber
+                case DeviceInformationService.firmwareRevisionStringCharacteristic: firmwareRevision
+                case DeviceInformationService.hardwareRevisionStringCharacteristic: configuration.hardwareRevision
+                default: nil
+                }
+            if let value {
+                completion(.success(Data(value.utf8)))
+            } else {
+                completion(.failure(AidlabError(message: "Characteristic \(uuid.uuidString) unavailable")))
+            }
+        }
+    }
+
+    public func writeCharacteristic(_ uuid: CBUUID, data: Data, withResponse _: Bool, completion: @escaping (Result<Void, Error>) -> Void) {
+        queue.async { [self] in
+            guard isConnected else {
+                completion(.failure(AidlabError(message: "Not connected")))
+                return
+            }
+            if random.draw() < configuration.writeFailureRate {
+                completion(.failure(AidlabError(message: "Simulated write failure")))
+                return
+            }
+            if uuid == cmdCharacteristicUUID {
+                receivedCommandBytes += data.count
+                releaseAnsweredSegments()
+            }
+            completion(.success(()))
+        }
+    }
+
+    public func startNotifications(_ uuid: CBUUID, onData: @escaping (Data) -> Void, onError _: @escaping (Error) -> Void) {
+        queue.async { [self] in
+            handlers[uuid] = onData
+            if releasedSegments == 0 {
+                releaseSegment()
+            }
+        }
+    }
+
+    public func stopNotifications(_ uuid: CBUUID) {
+        queue.async { [self] in
+            handlers[uuid] = nil
+        }
+    }
+
+    // -- Private --------------------------------------------------------------
+
+    /// Releases the answer to every outbound frame whose bytes have now been written in full.
+    private func releaseAnsweredSegments() {
+        while releasedSegments > 0, releasedSegments <= frameLengths.count,
+              receivedCommandBytes >= frameLengths[releasedSegments - 1]
+        {
+            receivedCommandBytes -= frameLengths[releasedSegments - 1]
+            releaseSegment()
+        }
+    }
+
+    private func releaseSegment() {
+        guard releasedSegments < segments.count else { return }
+        let segment = segments[releasedSegments]
+        releasedSegments += 1
+        guard let first = segment.first else { return }
+
+        let now = DispatchTime.now().uptimeNanoseconds
+        let start = max(now, pending.last?.due ?? 0)
+        for record in segment {
+            let offset = configuration.speed > 0
+                ? Double(record.hostTimeNanoseconds &- first.hostTimeNanoseconds) / configuration.speed
+                : 0
+            pending.append(Pending(record: record, due: start + UInt64(offset)))
+        }
+        if pending.count - pendingHead == segment.count {
+            scheduleDelivery()
+        }
+    }
+
+    private func scheduleDelivery() {
+        guard pendingHead < pending.count else { return }
+        let generation = generation
+        queue.asyncAfter(deadline: DispatchTime(uptimeNanoseconds: pending[pendingHead].due)) { [weak self] in
+            guard let self, self.generation == generation else { return }
+            deliverDueNotifications()
+        }
+    }
+
+    private func deliverDueNotifications() {
+        let now = DispatchTime.now().uptimeNanoseconds
+        while pendingHead < pending.count, pending[pendingHead].due <= now, isConnected {
+            let record = pending[pendingHead].record
+            pendingHead += 1
+            if random.draw() < configuration.notificationLoss {
+                continue
+            }
+            if let uuid = characteristic(for: record.kind), let handler = handlers[uuid] {
+                handler(record.bytes)
+            }
+        }
+        if pendingHead == pending.count {
+            pending.removeAll(keepingCapacity: true)
+            pendingHead = 0
+        } else {
+            scheduleDelivery()
+        }
+    }
+
+    private func characteristic(for kind: ChunkCapture.Kind) -> CBUUID? {
+        switch kind {
+        case .commandChunk: cmdCharacteristicUUID
+        case .outboundFrame: nil
+        default: LegacyCharacteristic.characteristic(for: kind)?.uuid
+        }
+    }
+}
+
+/// Small deterministic generator for the simulator's loss draws.
+private struct SplitMix64 {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    /// Uniform in 0..<1.
+    mutating func draw() -> Double {
+        state &+= 0x9E37_79B9_7F4A_7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58_476D_1CE4_E5B9
+        z = (z ^ (z >> 27)) &* 0x94D0_49BB_1331_11EB
+        z ^= z >> 31
+        return Double(z >> 11) / Double(UInt64(1) << 53)
+    }
+}
@@ -0,0 +1,117 @@
+import Foundation
+
+/// Implicit clock of a fixed-rate signal.
+///
+/// While a descriptor is current, sample `n` of the stream (counted from the first sample of the connection)
+/// has the timestamp `timestamp(ofSample: n)` to within half a sample period, so consumers can keep
+/// `sampleIndex`, `baseTimestamp` and `samplePeriod` instead of eight bytes per sample. A new descriptor is
+/// reported when samples were dropped or the device clock jumped.
+public struct StreamDescriptor: Sendable, Equatable {
+    public enum Reason: Sendable {
+        /// First descriptor of the stream in this connection.
+        case start
+        /// Samples are missing before `sampleIndex`; the stream continues at the same rate.
+        case gap
+        /// The timestamps no longer fit the previous clock, e.g. after a device clock adjustment.
+        case clockCorrection
+    }
+
+    public let signal: WaveformSignal
+    public let reason: Reason
+    /// Stream index of the sample at `baseTimestamp`.
+    public let sampleIndex: UInt64
+    public let baseTimestamp: UInt64
+    /// Nominal spacing between samples, in timestamp units.
+    public let samplePeriod: Double
+
+    public func timestamp(ofSample index: UInt64) -> UInt64 {
+        let offset = (Double(Int64(bitPattern: index &- sampleIndex)) * samplePeriod).rounded()
+        return baseTimestamp &+ UInt64(bitPattern: Int64(offset))
+    }
+}
+
+/// Follows the timestamps of one signal and reports a `StreamDescriptor` whenever they stop matching the
+/// current one.
+struct StreamClock {
+    let signal: WaveformSignal
+
+    private var descriptor: StreamDescriptor?
+    private var sampleCount: UInt64 = 0
+    private var lastTimestamp: UInt64 = 0
+
+    init(signal: WaveformSignal) {
+        self.signal = signal
+    }
+
+    /// Advances the stream by `timestamps`. Samples are counted whether or not `reportsChanges` is set, so
+    /// `sampleIndex` stays relative to the start of the connection; while it is off the clock is dropped, and
+    /// the next reported descriptor is a `.start`.
+    mutating func observe(
+        _ timestamps: UnsafeBufferPointer<UInt64>,
+        reportsChanges: Bool,
+        report: (StreamDescriptor) -> Void
+    ) {
+        guard reportsChanges else {
+            if let last = timestamps.last {
+                sampleCount += UInt64(timestamps.count)
+                lastTimestamp = last
+            }
+            descriptor = nil
+            return
+        }
+        for timestamp in timestamps {
+            defer {
+                sampleCount += 1
+                lastTimestamp = timestamp
+            }
+
+            guard let current = descriptor else {
+                // The period is only known from the second sample on. The clock is anchored at that sample, so the
+                // descriptor always precedes the block holding `sampleIndex`.
+                if sampleCount > 0, timestamp > lastTimestamp {
+                    start(at: sampleCount, timestamp: timestamp, period: Double(timestamp - lastTimestamp), report: report)
+                }
+                continue
+            }
+
+            let predicted = current.timestamp(ofSample: sampleCount)
+            let error = Double(Int64(bitPattern: timestamp &- predicted))
+            let tolerance = max(current.samplePeriod / 2, 1)
+            guard abs(error) > tolerance else { continue }
+
+            let missingSamples = (error / current.samplePeriod).rounded()
+            let reason: StreamDescriptor.Reason =
+                missingSamples >= 1 && abs(error - missingSamples * current.samplePeriod) <= tolerance
+                    ? .gap : .clockCorrection
+            let next = StreamDescriptor(
+                signal: signal,
+                reason: reason,
+                sampleIndex: sampleCount,
+                baseTimestamp: timestamp,
+                samplePeriod: refinedPeriod(of: current)
+            )
+            descriptor = next
+            report(next)
+        }
+    }
+
+    private mutating func start(at index: UInt64, timestamp: UInt64, period: Double, report: (StreamDescriptor) -> Void) {
+        let descriptor = StreamDescriptor(
+            signal: signal,
+            reason: .start,
+            sampleIndex: index,
+            baseTimestamp: timestamp,
+            samplePeriod: period
+        )
+        self.descriptor = descriptor
+        report(descriptor)
+    }
+
+    /// Mean period over the run that just ended, which is more accurate than the two-sample estimate it
+    /// started with.
+    private func refinedPeriod(of current: StreamDescriptor) -> Double {
+        let spannedSamples = sampleCount - 1 - current.sampleIndex
+        guard spannedSamples >= 2, lastTimestamp > current.baseTimestamp else { return current.samplePeriod }
+        return Double(lastTimestamp - current.baseTimestamp) / Double(spannedSamples)
+    }
+}
@@ -0,0 +1,107 @@
+import Foundation
+import os
+
+/// Intervals on the receive and send paths of a `Device`.
+public enum TraceEvent: UInt8, Sendable {
+    /// One notification inside the SDK decoder, including event callbacks it fires synchronously.
+    case chunkDecode
+    /// Delivery of the sample blocks decoded from one notification to the delegate.
+    case sampleDelivery
+    /// The SDK's BLE send callback: capturing, copying and queueing one outgoing frame.
+    case frameSend
+    /// One ATT write on the command characteristic, from submission to its completion callback.
+    case characteristicWrite
+
+    public var name: StaticString {
+        switch self {
+        case .chunkDecode: "chunkDecode"
+        case .sampleDelivery: "sampleDelivery"
+        case .frameSend: "frameSend"
+        case .characteristicWrite: "characteristicWrite"
+        }
+    }
+}
+
+/// Receives begin/end pairs from the trace points of every `Device` it is attached to.
+///
+/// Trace points are only compiled in when the package is built with `AIDLAB_TRACING=1` in the environment;
+/// otherwise `Device.tracer` is never called and costs nothing.
+public protocol AidlabTracer: AnyObject, Sendable {
+    /// Returns a token that is passed back to the matching `end`. Intervals may overlap and end on another thread.
+    func begin(_ event: TraceEvent) -> UInt64
+    func end(_ event: TraceEvent, token: UInt64)
+}
+
+/// Emits os_signpost intervals, visible in the Instruments os_signpost track.
+public final class SignpostTracer: AidlabTracer, @unchecked Sendable {
+    private let log: OSLog
+
+    public init(subsystem: String = "com.aidlab.sdk", category: String = "Device") {
+        log = OSLog(subsystem: subsystem, category: category)
+    }
+
+    public func begin(_ event: TraceEvent) -> UInt64 {
+        let id = OSSignpostID(log: log)
+        os_signpost(.begin, log: log, name: event.name, signpostID: id)
+        return id.rawValue
+    }
+
+    public func end(_ event: TraceEvent, token: UInt64) {
+        os_signpost(.end, log: log, name: event.name, signpostID: OSSignpostID(token))
+    }
+}
+
+/// Keeps the most recent trace records in memory, e.g. for tests or for dumping after a latency spike.
+public final class RingBufferTracer: AidlabTracer, @unchecked Sendable {
+    public struct Record: Sendable {
+        public let event: TraceEvent
+        public let isBegin: Bool
+        public let token: UInt64
+        public let uptimeNanoseconds: UInt64
+    }
+
+    public let capacity: Int
+
+    private let lock = NSLock()
+    private var ring: [Record?]
+    private var next = 0
+    private var nextToken: UInt64 = 0
+
+    public init(capacity: Int = 4096) {
+        self.capacity = max(1, capacity)
+        ring = Array(repeating: nil, count: self.capacity)
+    }
+
+    /// Retained records, oldest first.
+    public var records: [Record] {
+        lock.lock()
+        defer { lock.unlock() }
+        return (0 ..< capacity).compactMap { ring[(next + $0) % capacity] }
+    }
+
+    public func removeAll() {
+        lock.lock()
+        ring = Array(repeating: nil, count: capacity)
+        next = 0
+        lock.unlock()
+    }
+
+    public func begin(_ event: TraceEvent) -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        nextToken &+= 1
+        append(Record(event: event, isBegin: true, token: nextToken, uptimeNanoseconds: DispatchTime.now().uptimeNanoseconds))
+        return nextToken
+    }
+
+    public func end(_ event: TraceEvent, token: UInt64) {
+        lock.lock()
+        append(Record(event: event, isBegin: false, token: token, uptimeNanoseconds: DispatchTime.now().uptimeNanoseconds))
+        lock.unlock()
+    }
+
+    private func append(_ record: Record) {
+        ring[next] = record
+        next = (next + 1) % capacity
+    }
+}
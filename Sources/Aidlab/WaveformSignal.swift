@@ -0,0 +1,38 @@
+import Foundation
+
+/// Waveform signals that `Device` delivers as sample blocks, live and from synchronization.
+public enum WaveformSignal: CaseIterable, Sendable {
+    case ecg
+    case respiration
+    case skinTemperature
+    case accelerometer
+    case gyroscope
+    case magnetometer
+    case quaternion
+    case pastECG
+    case pastRespiration
+    case pastSkinTemperature
+    case pastAccelerometer
+    case pastGyroscope
+    case pastMagnetometer
+    case pastQuaternion
+
+    /// Number of value columns: 1 for scalar signals, x/y/z for vectors and w/x/y/z for quaternions.
+    public var columnCount: Int {
+        switch self {
+        case .ecg, .respiration, .skinTemperature, .pastECG, .pastRespiration, .pastSkinTemperature: 1
+        case .accelerometer, .gyroscope, .magnetometer, .pastAccelerometer, .pastGyroscope, .pastMagnetometer: 3
+        case .quaternion, .pastQuaternion: 4
+        }
+    }
+
+    public var dataType: DataType {
+        switch self {
+        case .ecg, .pastECG: .ecg
+        case .respiration, .pastRespiration: .respiration
+        case .skinTemperature, .pastSkinTemperature: .skinTemperature
+        case .accelerometer, .gyroscope, .magnetometer, .quaternion,
+             .pastAccelerometer, .pastGyroscope, .pastMagnetometer, .pastQuaternion: .motion
+        }
+    }
+}
@@ -0,0 +1,191 @@
+import Aidlab
+import AidlabSDK
+import Foundation
+
+#if canImport(Darwin)
+    import Darwin
+#endif
+
+/// Replays the inbound records of a `ChunkCapture` through fresh SDK instances with callbacks that only count.
+struct DecodeBenchmark {
+    struct Result {
+        let chunks: Int
+        let bytes: Int
+        /// Samples and measurements; battery, wear-state, exercise and user events are counted in `events`.
+        let samples: Int
+        let events: Int
+        let elapsedNanoseconds: UInt64
+        /// Live heap blocks after decoding minus before, summed over iterations.
+        let heapBlockDelta: Int
+
+        var chunksPerSecond: Double { Double(chunks) / seconds }
+        var samplesPerSecond: Double { Double(samples) / seconds }
+        var nanosecondsPerSample: Double { samples > 0 ? Double(elapsedNanoseconds) / Double(samples) : 0 }
+        /// Net heap growth per chunk. Blocks allocated and freed while decoding do not show up here, so 0 means the
+        /// decoder does not accumulate memory, not that it does not allocate.
+        var netHeapGrowthPerChunk: Double { chunks > 0 ? Double(heapBlockDelta) / Double(chunks) : 0 }
+
+        private var seconds: Double { max(Double(elapsedNanoseconds) / 1e9, .leastNonzeroMagnitude) }
+    }
+
+    let capture: ChunkCapture
+    let iterations: Int
+
+    func run() throws -> Result {
+        let records = capture.records.filter { $0.kind != .outboundFrame }
+        var chunks = 0
+        var bytes = 0
+        var samples = 0
+        var events = 0
+        var elapsed: UInt64 = 0
+        var heapBlockDelta = 0
+
+        for _ in 0 ..< iterations {
+            let counter = CallbackCounter()
+            var revision = Array(capture.firmwareRevision.utf8)
+            guard let aidlabSDK = AidlabSDK_create(&revision, Int32(revision.count)) else {
+                throw AidlabError(message: "SDK rejected firmware revision \(capture.firmwareRevision)")
+            }
+            let context = Unmanaged.passUnretained(counter).toOpaque()
+            installCountingCallbacks(context: context, aidlabSDK: aidlabSDK)
+
+            let heapBlocksBefore = heapBlocksInUse()
+            let start = DispatchTime.now().uptimeNanoseconds
+            for record in records {
+                record.bytes.withUnsafeBytes { buffer in
+                    process(record.kind, buffer.bindMemory(to: UInt8.self).baseAddress, Int32(buffer.count), aidlabSDK)
+                }
+                chunks += 1
+                bytes += record.bytes.count
+            }
+            elapsed += DispatchTime.now().uptimeNanoseconds - start
+            heapBlockDelta += heapBlocksInUse() - heapBlocksBefore
+
+            AidlabSDK_set_context(nil, aidlabSDK)
+            AidlabSDK_destroy(aidlabSDK)
+            samples += counter.samples
+            events += counter.events
+        }
+
+        return Result(
+            chunks: chunks,
+            bytes: bytes,
+            samples: samples,
+            events: events,
+            elapsedNanoseconds: elapsed,
+            heapBlockDelta: heapBlockDelta
+        )
+    }
+
+    private func process(
+        _ kind: ChunkCapture.Kind,
+        _ bytes: UnsafePointer<UInt8>?,
+        _ count: Int32,
+        _ aidlabSDK: UnsafeMutableRawPointer
+    ) {
+        switch kind {
+        case .commandChunk: AidlabSDK_process_ble_chunk(bytes, count, aidlabSDK)
+        case .legacyECG: processECGPackage(bytes, count, aidlabSDK)
+        case .legacyTemperature: processTemperaturePackage(bytes, count, aidlabSDK)
+        case .legacyRespiration: processRespirationPackage(bytes, count, aidlabSDK)
+        case .legacyMotion: processMotionPackage(bytes, count, aidlabSDK)
+        case .legacySoundVolume: processSoundVolumePackage(bytes, count, aidlabSDK)
+        case .legacySteps: processStepsPackage(bytes, count, aidlabSDK)
+        case .legacyActivity: processActivityPackage(bytes, count, aidlabSDK)
+        case .legacyOrientation: processOrientationPackage(bytes, count, aidlabSDK)
+        case .legacyHeartRate: processHeartRatePackage(bytes, count, aidlabSDK)
+        case .battery: AidlabSDK_process_battery_package(bytes, count, aidlabSDK)
+        case .outboundFrame: break
+        }
+    }
+}
+
+/// Live heap blocks in the default zone. Differences only show net growth: an allocation freed before the next
+/// reading, such as a temporary inside one chunk, is invisible.
+private func heapBlocksInUse() -> Int {
+    #if canImport(Darwin)
+        var statistics = malloc_statistics_t()
+        malloc_zone_statistics(nil, &statistics)
+        return Int(statistics.blocks_in_use)
+    #else
+        return 0
+    #endif
+}
+
+private final class CallbackCounter {
+    var samples = 0
+    var events = 0
+}
+
+private func countSample(_ context: UnsafeMutableRawPointer?) {
+    guard let context else { return }
+    Unmanaged<CallbackCounter>.fromOpaque(context).takeUnretainedValue().samples += 1
+}
+
+private func countEvent(_ context: UnsafeMutableRawPointer?) {
+    guard let context else { return }
+    Unmanaged<CallbackCounter>.fromOpaque(context).takeUnretainedValue().events += 1
+}
+
+private func installCountingCallbacks(context: UnsafeMutableRawPointer, aidlabSDK: UnsafeMutableRawPointer) {
+    AidlabSDK_set_context(context, aidlabSDK)
+    AidlabSDK_set_error_callback({ _, _, _ in }, context, aidlabSDK)
+    AidlabSDK_set_ble_send_callback({ _, _, _ in }, aidlabSDK)
+    AidlabSDK_set_ble_ready_callback({ _ in }, aidlabSDK)
+    AidlabSDK_set_payload_callback({ _, _, _, _, _ in }, aidlabSDK)
+    AidlabSDK_set_process_error_callback({ _, _, _, _, _, _ in }, aidlabSDK)
+
+    AidlabSDK_init_callbacks(
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _ in countEvent(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _ in countEvent(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _ in countEvent(context) },
+        { context, _ in countEvent(context) },
+        { context, _, _ in countSample(context) },
+        { context, _ in countEvent(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        aidlabSDK
+    )
+    AidlabSDK_set_eda_callback({ context, _, _ in countSample(context) }, aidlabSDK)
+    AidlabSDK_set_gps_callback({ context, _, _, _, _, _, _, _ in countSample(context) }, aidlabSDK)
+
+    AidlabSDK_init_synchronization_callbacks(
+        { _, _ in },
+        { _, _, _ in },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _ in countEvent(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        { context, _, _ in countSample(context) },
+        aidlabSDK
+    )
+    AidlabSDK_set_past_eda_callback({ context, _, _ in countSample(context) }, aidlabSDK)
+    AidlabSDK_set_past_gps_callback({ context, _, _, _, _, _, _, _ in countSample(context) }, aidlabSDK)
+}
@@ -0,0 +1,12 @@
+import Aidlab
+import Foundation
+
+/// Replays a `ChunkCapture` through a `Device` on a mock transport and reports notification-to-delegate latency.
+struct LatencyBenchmark {
+    let capture: ChunkCapture
+
+    func run() throws -> [DataType: LatencySummary] {
+        let device = try capture.replay(delegate: NullDeviceDelegate()) { $0.measuresLatency = true }
+        return device.latency
+    }
+}
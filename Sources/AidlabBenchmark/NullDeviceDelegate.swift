@@ -0,0 +1,74 @@
+import Aidlab
+import Foundation
+
+/// Receives everything and does nothing, including the block callbacks, so replays measure the SDK alone.
+final class NullDeviceDelegate: DeviceDelegate {
+    func didReceiveECG(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceiveRespiration(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceiveBatteryLevel(_: Device, stateOfCharge _: UInt8) {}
+    func didReceiveSteps(_: Device, timestamp _: UInt64, value _: UInt64) {}
+    func didReceiveSkinTemperature(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceiveAccelerometer(_: Device, timestamp _: UInt64, ax _: Float, ay _: Float, az _: Float) {}
+    func didReceiveGyroscope(_: Device, timestamp _: UInt64, gx _: Float, gy _: Float, gz _: Float) {}
+    func didReceiveMagnetometer(_: Device, timestamp _: UInt64, mx _: Float, my _: Float, mz _: Float) {}
+    func didReceiveQuaternion(_: Device, timestamp _: UInt64, qw _: Float, qx _: Float, qy _: Float, qz _: Float) {}
+    func didReceiveOrientation(_: Device, timestamp _: UInt64, roll _: Float, pitch _: Float, yaw _: Float) {}
+    func didReceiveEDA(_: Device, timestamp _: UInt64, conductance _: Float) {}
+    func didReceiveGPS(_: Device, timestamp _: UInt64, latitude _: Double, longitude _: Double, altitude _: Double, speed _: Float, heading _: Float, hdop _: Float) {}
+    func didReceiveBodyPosition(_: Device, timestamp _: UInt64, bodyPosition _: BodyPosition) {}
+    func didReceiveHeartRate(_: Device, timestamp _: UInt64, heartRate _: Int32) {}
+    func didReceiveRr(_: Device, timestamp _: UInt64, rr _: Int32) {}
+    func didReceiveRespirationRate(_: Device, timestamp _: UInt64, value _: UInt32) {}
+    func didReceiveSoundVolume(_: Device, timestamp _: UInt64, soundVolume _: UInt16) {}
+    func didDetectExercise(_: Device, exercise _: Exercise) {}
+    func didReceiveActivity(_: Device, timestamp _: UInt64, activity _: ActivityType) {}
+    func didDisconnect(_: Device, reason _: DisconnectReason) {}
+    func didConnect(_: Device) {}
+    func didReceiveError(_: Device, error _: AidlabError) {}
+    func didUpdateRSSI(_: Device, rssi _: Int32) {}
+    func wearStateDidChange(_: Device, wearState _: WearState) {}
+    func didReceivePayload(_: Device, process _: String, payload _: Data, options _: UInt64) {}
+    func didReceiveProcessError(_: Device, process _: String, pid _: UInt16, payload _: Data, options _: UInt64) {}
+    func processDidTerminate(_: Device, pid _: UInt16) {}
+    func didDetectUserEvent(_: Device, timestamp _: UInt64) {}
+    func didReceiveSignalQuality(_: Device, timestamp _: UInt64, value _: Int32) {}
+    func syncStateDidChange(_: Device, state _: SyncState) {}
+    func didReceivePastECG(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceivePastRespiration(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceivePastSkinTemperature(_: Device, timestamp _: UInt64, value _: Float) {}
+    func didReceivePastHeartRate(_: Device, timestamp _: UInt64, heartRate _: Int32) {}
+    func didReceivePastRr(_: Device, timestamp _: UInt64, rr _: Int32) {}
+    func didReceiveUnsynchronizedSize(_: Device, unsynchronizedSize _: UInt32, syncBytesPerSecond _: Float) {}
+    func didReceivePastRespirationRate(_: Device, timestamp _: UInt64, value _: UInt32) {}
+    func didReceivePastActivity(_: Device, timestamp _: UInt64, activity _: ActivityType) {}
+    func didReceivePastSteps(_: Device, timestamp _: UInt64, value _: UInt64) {}
+    func didReceivePastSoundVolume(_: Device, timestamp _: UInt64, soundVolume _: UInt16) {}
+    func didReceivePastAccelerometer(_: Device, timestamp _: UInt64, ax _: Float, ay _: Float, az _: Float) {}
+    func didReceivePastGyroscope(_: Device, timestamp _: UInt64, gx _: Float, gy _: Float, gz _: Float) {}
+    func didReceivePastMagnetometer(_: Device, timestamp _: UInt64, mx _: Float, my _: Float, mz _: Float) {}
+    func didReceivePastQuaternion(_: Device, timestamp _: UInt64, qw _: Float, qx _: Float, qy _: Float, qz _: Float) {}
+    func didReceivePastOrientation(_: Device, timestamp _: UInt64, roll _: Float, pitch _: Float, yaw _: Float) {}
+    func didReceivePastEDA(_: Device, timestamp _: UInt64, conductance _: Float) {}
+    func didReceivePastGPS(_: Device, timestamp _: UInt64, latitude _: Double, longitude _: Double, altitude _: Double, speed _: Float, heading _: Float, hdop _: Float) {}
+    func didReceivePastBodyPosition(_: Device, timestamp _: UInt64, bodyPosition _: BodyPosition) {}
+    func didReceivePastPressure(_: Device, timestamp _: UInt64, value _: Int32) {}
+    func didDetectPastUserEvent(_: Device, timestamp _: UInt64) {}
+    func didReceivePastSignalQuality(_: Device, timestamp _: UInt64, value _: UInt8) {}
+    func pressureWearStateDidChange(_: Device, wearState _: WearState) {}
+    func didReceivePressure(_: Device, timestamp _: UInt64, value _: Int32) {}
+    func didReceiveECG(_: Device, samples _: SampleBlock) {}
+    func didReceiveRespiration(_: Device, samples _: SampleBlock) {}
+    func didReceiveSkinTemperature(_: Device, samples _: SampleBlock) {}
+    func didReceivePastECG(_: Device, samples _: SampleBlock) {}
+    func didReceivePastRespiration(_: Device, samples _: SampleBlock) {}
+    func didReceivePastSkinTemperature(_: Device, samples _: SampleBlock) {}
+    func didReceiveAccelerometer(_: Device, samples _: VectorBlock) {}
+    func didReceiveGyroscope(_: Device, samples _: VectorBlock) {}
+    func didReceiveMagnetometer(_: Device, samples _: VectorBlock) {}
+    func didReceiveQuaternion(_: Device, samples _: QuaternionBlock) {}
+    func didReceivePastAccelerometer(_: Device, samples _: VectorBlock) {}
+    func didReceivePastGyroscope(_: Device, samples _: VectorBlock) {}
+    func didReceivePastMagnetometer(_: Device, samples _: VectorBlock) {}
+    func didReceivePastQuaternion(_: Device, samples _: QuaternionBlock) {}
+    func streamDescriptorDidChange(_: Device, descriptor _: StreamDescriptor) {}
+}
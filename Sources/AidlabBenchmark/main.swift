@@ -0,0 +1,60 @@
+import Aidlab
+import Foundation
+
+// Usage: swift run -c release AidlabBenchmark [--iterations N] [--latency] <capture.alcp>...
+
+var iterations = 10
+var reportsLatency = false
+var paths: [String] = []
+var arguments = CommandLine.arguments.dropFirst()
+
+while let argument = arguments.popFirst() {
+    if argument == "--iterations", let value = arguments.popFirst().flatMap(Int.init), value > 0 {
+        iterations = value
+    } else if argument == "--latency" {
+        reportsLatency = true
+    } else {
+        paths.append(argument)
+    }
+}
+
+guard !paths.isEmpty else {
+    print("usage: AidlabBenchmark [--iterations N] [--latency] <capture>...")
+    exit(64)
+}
+
+print("capture".padding(toLength: 32, withPad: " ", startingAt: 0)
+    + "  firmware      chunks/s     samples/s   ns/sample  net heap growth/chunk      events")
+
+var failed = false
+for path in paths {
+    let url = URL(fileURLWithPath: path)
+    do {
+        let capture = try ChunkCapture(contentsOf: url)
+        let result = try DecodeBenchmark(capture: capture, iterations: iterations).run()
+        print(url.lastPathComponent.padding(toLength: 32, withPad: " ", startingAt: 0)
+            + "  " + capture.firmwareRevision.padding(toLength: 10, withPad: " ", startingAt: 0)
+            + String(format: " %12.0f  %12.0f  %10.1f  %22.3f  %10ld",
+                     result.chunksPerSecond,
+                     result.samplesPerSecond,
+                     result.nanosecondsPerSample,
+                     result.netHeapGrowthPerChunk,
+                     result.events))
+        if reportsLatency {
+            let latency = try LatencyBenchmark(capture: capture).run()
+            for (dataType, summary) in latency.sorted(by: { $0.key.rawValue < $1.key.rawValue }) {
+                print("  latency " + "\(dataType)".padding(toLength: 16, withPad: " ", startingAt: 0)
+                    + String(format: " n=%-8llu p50 %8.1f us  p99 %8.1f us  max %8.1f us",
+                             summary.count,
+                             Double(summary.p50Nanoseconds) / 1e3,
+                             Double(summary.p99Nanoseconds) / 1e3,
+                             Double(summary.maxNanoseconds) / 1e3))
+            }
+        }
+    } catch {
+        print("\(url.lastPathComponent): \(error)")
+        failed = true
+    }
+}
+
+exit(failed ? 1 : 0)
@@ -0,0 +1,56 @@
+@testable import Aidlab
+import XCTest
+
+final class BLEChunkQueueTests: XCTestCase {
+    func testSplitsFramesIntoChunksAndMarksOnlyTheLast() {
+        var queue = BLEChunkQueue()
+        let frame = Data((0 ..< 45).map { UInt8($0) })
+        queue.enqueueFrame(frame, chunkSize: 20, completesFrame: true)
+
+        XCTAssertEqual(queue.count, 3)
+        let chunks = [queue.popFirst(), queue.popFirst(), queue.popFirst()].compactMap { $0 }
+        XCTAssertEqual(chunks.map(\.data.count), [20, 20, 5])
+        XCTAssertEqual(chunks.map(\.completesFrame), [false, false, true])
+        XCTAssertEqual(Data(chunks.map(\.data).joined()), frame)
+        XCTAssertNil(queue.popFirst())
+    }
+
+    func testFrameThatDoesNotCompleteLeavesEveryChunkOpen() {
+        var queue = BLEChunkQueue()
+        queue.enqueueFrame(Data(count: 30), chunkSize: 20, completesFrame: false)
+
+        XCTAssertEqual(queue.popFirst()?.completesFrame, false)
+        XCTAssertEqual(queue.popFirst()?.completesFrame, false)
+    }
+
+    func testKeepsOrderAcrossWrapAroundAndGrowth() {
+        var queue = BLEChunkQueue(capacity: 2)
+        queue.enqueueFrame(Data([1]), chunkSize: 20, completesFrame: true)
+        queue.enqueueFrame(Data([2]), chunkSize: 20, completesFrame: true)
+        XCTAssertEqual(queue.popFirst()?.data, Data([1]))
+
+        // The head is now in the middle of the ring when it has to grow.
+        for byte in UInt8(3) ... 6 {
+            queue.enqueueFrame(Data([byte]), chunkSize: 20, completesFrame: true)
+        }
+
+        var popped: [UInt8] = []
+        while let chunk = queue.popFirst() {
+            popped += chunk.data
+        }
+        XCTAssertEqual(popped, [2, 3, 4, 5, 6])
+        XCTAssertTrue(queue.isEmpty)
+    }
+
+    func testRemoveAllEmptiesTheQueue() {
+        var queue = BLEChunkQueue(capacity: 4)
+        queue.enqueueFrame(Data(count: 100), chunkSize: 20, completesFrame: true)
+        queue.removeAll()
+
+        XCTAssertTrue(queue.isEmpty)
+        XCTAssertNil(queue.popFirst())
+
+        queue.enqueueFrame(Data([7]), chunkSize: 20, completesFrame: true)
+        XCTAssertEqual(queue.popFirst()?.data, Data([7]))
+    }
+}
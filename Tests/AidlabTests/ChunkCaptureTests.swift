@@ -0,0 +1,54 @@
+@testable import Aidlab
+import XCTest
+
+final class ChunkCaptureTests: XCTestCase {
+    func testRoundTripsRecordsAndRevision() throws {
+        let capture = ChunkCapture(firmwareRevision: "4.0.1", reservedCapacity: 0)
+        capture.append(.commandChunk, Data([1, 2, 3]))
+        capture.append(.legacyECG, Data())
+        capture.append(.outboundFrame, Data(repeating: 0xAB, count: 300))
+
+        let loaded = try ChunkCapture(data: capture.data)
+
+        XCTAssertEqual(loaded.firmwareRevision, "4.0.1")
+        XCTAssertEqual(loaded.records.map(\.kind), [.commandChunk, .legacyECG, .outboundFrame])
+        XCTAssertEqual(loaded.records.map(\.bytes), [Data([1, 2, 3]), Data(), Data(repeating: 0xAB, count: 300)])
+        let hostTimes = loaded.records.map(\.hostTimeNanoseconds)
+        XCTAssertEqual(hostTimes, hostTimes.sorted())
+    }
+
+    func testRejectsTruncatedRecords() {
+        let capture = ChunkCapture(firmwareRevision: "3.7.90")
+        capture.append(.battery, Data([42, 43]))
+        let data = capture.data
+
+        XCTAssertThrowsError(try ChunkCapture(data: data.dropLast()))
+        XCTAssertThrowsError(try ChunkCapture(data: data.prefix(data.count - 3)))
+    }
+
+    func testRejectsForeignHeaders() {
+        XCTAssertThrowsError(try ChunkCapture(data: Data("ALSR\u{1}\u{0}".utf8)))
+        XCTAssertThrowsError(try ChunkCapture(data: Data("ALCP\u{9}\u{0}".utf8)))
+        // Revision length points past the end.
+        XCTAssertThrowsError(try ChunkCapture(data: Data("ALCP\u{1}\u{5}4.0".utf8)))
+    }
+
+    func testSkipsRecordsOfUnknownKind() throws {
+        var bytes = Array("ALCP".utf8) + [1, 0]
+        bytes += [200] + [UInt8](repeating: 0, count: 8) + [2, 0, 0, 0] + [9, 9]
+        bytes += [ChunkCapture.Kind.battery.rawValue] + [UInt8](repeating: 0, count: 8) + [1, 0, 0, 0] + [77]
+
+        let capture = try ChunkCapture(data: Data(bytes))
+
+        XCTAssertEqual(capture.records.map(\.kind), [.battery])
+        XCTAssertEqual(capture.records.first?.bytes, Data([77]))
+    }
+
+    func testLegacyCharacteristicsMatchTheirKinds() {
+        for characteristic in LegacyCharacteristic.all {
+            XCTAssertEqual(LegacyCharacteristic.characteristic(for: characteristic.uuid)?.kind, characteristic.kind)
+        }
+        XCTAssertNil(LegacyCharacteristic.characteristic(for: .commandChunk))
+        XCTAssertNil(LegacyCharacteristic.characteristic(for: .outboundFrame))
+    }
+}
@@ -0,0 +1,52 @@
+@testable import Aidlab
+import XCTest
+
+final class LatencyHistogramTests: XCTestCase {
+    func testEmptyHistogramReportsZero() {
+        let summary = LatencyHistogram().summary
+
+        XCTAssertEqual(summary.count, 0)
+        XCTAssertEqual(summary.p50Nanoseconds, 0)
+        XCTAssertEqual(summary.maxNanoseconds, 0)
+    }
+
+    func testSmallValuesAreExact() {
+        var histogram = LatencyHistogram()
+        for value: UInt64 in [3, 3, 3, 9] {
+            histogram.record(value)
+        }
+
+        XCTAssertEqual(histogram.value(atQuantile: 0.5), 3)
+        XCTAssertEqual(histogram.value(atQuantile: 1), 9)
+    }
+
+    func testPercentilesStayWithinBucketPrecision() {
+        var histogram = LatencyHistogram()
+        for value in UInt64(1) ... 1000 {
+            histogram.record(value * 1000)
+        }
+
+        for (quantile, exact) in [(0.5, 500_000.0), (0.9, 900_000.0), (0.99, 990_000.0)] {
+            let value = Double(histogram.value(atQuantile: quantile))
+            XCTAssertGreaterThanOrEqual(value, exact)
+            XCTAssertLessThanOrEqual(value, exact * 1.125)
+        }
+        XCTAssertEqual(histogram.summary.count, 1000)
+        XCTAssertEqual(histogram.summary.maxNanoseconds, 1_000_000)
+    }
+
+    func testReportsAreCappedAtTheMaximum() {
+        var histogram = LatencyHistogram()
+        histogram.record(1_000_001)
+
+        XCTAssertEqual(histogram.value(atQuantile: 0.99), 1_000_001)
+    }
+
+    func testHandlesTheFullRange() {
+        var histogram = LatencyHistogram()
+        histogram.record(UInt64.max)
+
+        XCTAssertEqual(histogram.summary.maxNanoseconds, UInt64.max)
+        XCTAssertEqual(histogram.value(atQuantile: 0.5), UInt64.max)
+    }
+}
@@ -0,0 +1,61 @@
+@testable import Aidlab
+import XCTest
+
+final class SampleRingTests: XCTestCase {
+    private func push(_ timestamps: ClosedRange<UInt64>, into ring: SampleRing) {
+        let buffer = SampleBlockBuffer(columnCount: 3)
+        for timestamp in timestamps {
+            let value = Float(timestamp)
+            buffer.append(timestamp, value, value * 2, value * 3)
+        }
+        ring.push(buffer)
+    }
+
+    private func drain(_ ring: SampleRing, maxCount: Int = .max) -> [[UInt64]] {
+        var segments: [[UInt64]] = []
+        ring.drain(maxCount: maxCount) { segment in
+            segments.append(Array(segment.timestamps))
+            for (index, timestamp) in segment.timestamps.enumerated() {
+                XCTAssertEqual(segment.column(0)[index], Float(timestamp))
+                XCTAssertEqual(segment.column(1)[index], Float(timestamp) * 2)
+                XCTAssertEqual(segment.column(2)[index], Float(timestamp) * 3)
+            }
+        }
+        return segments
+    }
+
+    func testDrainsInOrderAcrossTheEndOfStorage() {
+        let ring = SampleRing(signal: .accelerometer, capacity: 4)
+        push(1 ... 3, into: ring)
+        XCTAssertEqual(drain(ring, maxCount: 2), [[1, 2]])
+        XCTAssertEqual(ring.count, 1)
+
+        push(4 ... 6, into: ring)
+        XCTAssertEqual(drain(ring), [[3, 4], [5, 6]])
+        XCTAssertEqual(ring.count, 0)
+        XCTAssertEqual(ring.overflowCount, 0)
+    }
+
+    func testDropsAndCountsSamplesThatDoNotFit() {
+        let ring = SampleRing(signal: .accelerometer, capacity: 4)
+        push(1 ... 6, into: ring)
+
+        XCTAssertEqual(ring.count, 4)
+        XCTAssertEqual(ring.overflowCount, 2)
+        XCTAssertEqual(drain(ring), [[1, 2, 3, 4]])
+    }
+
+    func testEmptyRingDrainsNothing() {
+        let ring = SampleRing(signal: .accelerometer, capacity: 4)
+
+        XCTAssertEqual(ring.drain { _ in XCTFail("Empty ring passed a segment") }, 0)
+    }
+
+    func testRingsExistOnlyForTheChosenSignals() {
+        let rings = SampleRings(signals: [.ecg, .pastQuaternion, .ecg], capacity: 8)
+
+        XCTAssertEqual(rings[.ecg]?.capacity, 8)
+        XCTAssertEqual(rings[.pastQuaternion]?.signal, .pastQuaternion)
+        XCTAssertNil(rings[.respiration])
+    }
+}
@@ -0,0 +1,68 @@
+@testable import Aidlab
+import XCTest
+
+final class SignalRecorderTests: XCTestCase {
+    private let url = FileManager.default.temporaryDirectory.appendingPathComponent("\(UUID().uuidString).alsr")
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: url)
+    }
+
+    func testRoundTripsTimestampsAndColumns() throws {
+        // Deltas that are zero, negative, wider than 32 bits and wrapping around the top of the range.
+        let timestamps: [UInt64] = [100, 100, 50, 1 << 40, (1 << 40) + 1, UInt64.max, 3]
+        let values: [Float] = [0, -1.5, .greatestFiniteMagnitude, -.leastNonzeroMagnitude, 42, 1e-7, -0.0]
+
+        let recorder = try SignalRecorder(url: url, samplesPerBlock: 3)
+        let ecg = SampleBlockBuffer()
+        let accelerometer = SampleBlockBuffer(columnCount: 3)
+        for (timestamp, value) in zip(timestamps, values) {
+            ecg.append(timestamp, value)
+            accelerometer.append(timestamp, value, -value, value * 2)
+            recorder.record(.ecg, ecg)
+            recorder.record(.pastAccelerometer, accelerometer)
+            ecg.removeAll()
+            accelerometer.removeAll()
+        }
+        try recorder.close()
+        XCTAssertEqual(recorder.failedBlockCount, 0)
+
+        let recording = try SignalRecording(contentsOf: url)
+        // 7 samples in blocks of 3: two full blocks per signal written on the I/O queue, one partial on close.
+        XCTAssertEqual(recording.blocks.count, 6)
+
+        let recordedECG = try recording.samples(of: .ecg)
+        XCTAssertEqual(recordedECG.timestamps, timestamps)
+        XCTAssertEqual(recordedECG.columns.map { $0.map(\.bitPattern) }, [values.map(\.bitPattern)])
+
+        let recordedAccelerometer = try recording.samples(of: .pastAccelerometer)
+        XCTAssertEqual(recordedAccelerometer.timestamps, timestamps)
+        XCTAssertEqual(recordedAccelerometer.columns, [values, values.map { -$0 }, values.map { $0 * 2 }])
+
+        XCTAssertTrue(try recording.samples(of: .respiration).timestamps.isEmpty)
+    }
+
+    func testIgnoresSamplesAfterClose() throws {
+        let recorder = try SignalRecorder(url: url, samplesPerBlock: 1)
+        try recorder.close()
+
+        let buffer = SampleBlockBuffer()
+        buffer.append(1, 1)
+        recorder.record(.ecg, buffer)
+        try recorder.close()
+
+        XCTAssertTrue(try SignalRecording(contentsOf: url).blocks.isEmpty)
+    }
+
+    func testRejectsForeignFiles() throws {
+        try Data("ALCP\u{1}".utf8).write(to: url)
+        XCTAssertThrowsError(try SignalRecording(contentsOf: url))
+    }
+
+    func testMapsSignalsToFileTags() {
+        for signal in WaveformSignal.allCases {
+            XCTAssertEqual(RecordedSignal(signal).signal, signal)
+        }
+        XCTAssertEqual(RecordedSignal(.pastQuaternion).rawValue, 22)
+    }
+}
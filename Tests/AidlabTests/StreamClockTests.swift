@@ -0,0 +1,73 @@
+@testable import Aidlab
+import XCTest
+
+final class StreamClockTests: XCTestCase {
+    private var clock = StreamClock(signal: .ecg)
+    private var reported: [StreamDescriptor] = []
+
+    private func observe(_ timestamps: [UInt64], reportsChanges: Bool = true) {
+        timestamps.withUnsafeBufferPointer { buffer in
+            clock.observe(buffer, reportsChanges: reportsChanges) { reported.append($0) }
+        }
+    }
+
+    func testStartIsAnchoredAtTheSecondSample() {
+        observe([0])
+        XCTAssertTrue(reported.isEmpty)
+
+        observe([10, 20])
+        XCTAssertEqual(reported.count, 1)
+        XCTAssertEqual(reported[0].reason, .start)
+        XCTAssertEqual(reported[0].sampleIndex, 1)
+        XCTAssertEqual(reported[0].baseTimestamp, 10)
+        XCTAssertEqual(reported[0].samplePeriod, 10)
+        XCTAssertEqual(reported[0].timestamp(ofSample: 0), 0)
+        XCTAssertEqual(reported[0].timestamp(ofSample: 2), 20)
+    }
+
+    func testSteadyStreamReportsOnlyItsStart() {
+        observe([0, 10, 20, 30])
+        observe([40, 50, 61, 69])
+
+        XCTAssertEqual(reported.map(\.reason), [.start])
+    }
+
+    func testDroppedSamplesAreReportedAsGap() {
+        observe([0, 10, 20, 30, 40, 50])
+        observe([80, 90])
+
+        XCTAssertEqual(reported.map(\.reason), [.start, .gap])
+        XCTAssertEqual(reported[1].sampleIndex, 6)
+        XCTAssertEqual(reported[1].baseTimestamp, 80)
+        XCTAssertEqual(reported[1].samplePeriod, 10)
+    }
+
+    func testClockJumpBackIsReportedAsCorrection() {
+        observe([1000, 1010, 1020])
+        observe([500])
+
+        XCTAssertEqual(reported.map(\.reason), [.start, .clockCorrection])
+        XCTAssertEqual(reported[1].sampleIndex, 3)
+        XCTAssertEqual(reported[1].baseTimestamp, 500)
+    }
+
+    func testCountsSamplesWhileReportingIsOff() {
+        observe([0, 10, 20], reportsChanges: false)
+        XCTAssertTrue(reported.isEmpty)
+
+        observe([30, 40])
+        XCTAssertEqual(reported.count, 1)
+        XCTAssertEqual(reported[0].reason, .start)
+        XCTAssertEqual(reported[0].sampleIndex, 3)
+        XCTAssertEqual(reported[0].baseTimestamp, 30)
+    }
+
+    func testReportingTurnedOffAndOnStartsAFreshClock() {
+        observe([0, 10, 20])
+        observe([30, 40], reportsChanges: false)
+        observe([50, 60])
+
+        XCTAssertEqual(reported.map(\.reason), [.start, .start])
+        XCTAssertEqual(reported[1].sampleIndex, 5)
+    }
+}